@@ -1,14 +1,10 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <SDL2/SDL.h>
+#include <string.h>
 #include "APU.h"    
 #include "MMU.h"
 #include <math.h>
 
-extern SDL_AudioSpec audio;
-extern SDL_AudioSpec audio2;
-extern SDL_AudioDeviceID audioDevice;
-
 static const uint8_t DutyCycles[4][8] = {
     {0, 0, 0, 0, 0, 0, 0, 1}, // 12.5%
     {1, 0, 0, 0, 0, 0, 0, 1}, // 25%
@@ -66,70 +62,107 @@ void APUInit(APU *APU, MMU *MMU) {
     APU->Noise.Timer = 0;
     APU->Noise.LSFR = 0x7FFF;
 
-    APU->MasterSampleLeft = 0;
-    APU->MasterSampleRight = 0;
     APU->FrameSequencerStep = 0;
     APU->FrameSequencerCounter = 8192;
-    APU->CurrentSample = 0;
-    APU->SampleTimer = 0;
     APU->Ticks = 0;
+    APULoadRegisters(APU, MMU);
 }
 
-void APUUpdate(APU *APU, MMU *MMU) {
+//Copies every sound register out of the MMU without triggering anything, for when they were set without going through APUWriteRegister.
+void APULoadRegisters(APU *APU, MMU *MMU) {
     APU->NR50 = MMU->SystemMemory[0xFF24];
     APU->NR51 = MMU->SystemMemory[0xFF25];
     APU->NR52 = MMU->SystemMemory[0xFF26];
 
-    // Channel 1
     APU->PulseWithSweep.NR10 = MMU->SystemMemory[0xFF10];
     APU->PulseWithSweep.NR11 = MMU->SystemMemory[0xFF11];
     APU->PulseWithSweep.NR12 = MMU->SystemMemory[0xFF12];
     APU->PulseWithSweep.NR13 = MMU->SystemMemory[0xFF13];
-    if (APU->PulseWithSweep.NR14 != MMU->SystemMemory[0xFF14]) {
-        if ((MMU->SystemMemory[0xFF14] & 0x80) == 0x80) {
-            APUPulseWithSweepTrigger(APU, MMU);
-        }
-    }
     APU->PulseWithSweep.NR14 = MMU->SystemMemory[0xFF14];
 
-    // Channel 2
     APU->Pulse.NR21 = MMU->SystemMemory[0xFF16];
     APU->Pulse.NR22 = MMU->SystemMemory[0xFF17];
     APU->Pulse.NR23 = MMU->SystemMemory[0xFF18];
-    if (APU->Pulse.NR24 != MMU->SystemMemory[0xFF19]) {
-        if ((MMU->SystemMemory[0xFF19] & 0x80) == 0x80) {
-            APUPulseTrigger(APU, MMU);
-        }
-    }
     APU->Pulse.NR24 = MMU->SystemMemory[0xFF19];
 
-    // Channel 3
     APU->Wave.NR30 = MMU->SystemMemory[0xFF1A];
     APU->Wave.NR31 = MMU->SystemMemory[0xFF1B];
     APU->Wave.NR32 = MMU->SystemMemory[0xFF1C];
     APU->Wave.NR33 = MMU->SystemMemory[0xFF1D];
-    if (APU->Wave.NR34 != MMU->SystemMemory[0xFF1E]) {
-        if ((MMU->SystemMemory[0xFF1E] & 0x80) == 0x80) {
-            APUWaveTrigger(APU, MMU);
-        }
-    }
     APU->Wave.NR34 = MMU->SystemMemory[0xFF1E];
-    for (int i = 0xFF30; i <= 0xFF3F; i++) {
-        APU->Wave.WavePatternRAM[i - 0xFF30] = MMU->SystemMemory[i];
-    }
+    memcpy(APU->Wave.WavePatternRAM, MMU->SystemMemory + 0xFF30, 16);
 
-    // Channel 4
     APU->Noise.NR41 = MMU->SystemMemory[0xFF20];
     APU->Noise.NR42 = MMU->SystemMemory[0xFF21];
     APU->Noise.NR43 = MMU->SystemMemory[0xFF22];
-    if (APU->Noise.NR44 != MMU->SystemMemory[0xFF23]) {
-        if ((MMU->SystemMemory[0xFF23] & 0x80) == 0x80) {
-            APUNoiseTrigger(APU, MMU);
-        }
-    }
     APU->Noise.NR44 = MMU->SystemMemory[0xFF23];
 }
 
+/*Write to a sound register (0xFF10-0xFF3F), called by the MMU once the APU has been run up to the write.
+  Every write to NRx4 with bit 7 set triggers its channel, even if the value is the same as before. */
+void APUWriteRegister(APU *APU, MMU *MMU, uint16_t address, uint8_t value) {
+    MMU->SystemMemory[address] = value;
+
+    switch (address) {
+        // Channel 1
+        case 0xFF10: APU->PulseWithSweep.NR10 = value; break;
+        case 0xFF11: APU->PulseWithSweep.NR11 = value; break;
+        case 0xFF12: APU->PulseWithSweep.NR12 = value; break;
+        case 0xFF13: APU->PulseWithSweep.NR13 = value; break;
+        case 0xFF14:
+            APU->PulseWithSweep.NR14 = value;
+            if (value & 0x80) APUPulseWithSweepTrigger(APU, MMU);
+            break;
+
+        // Channel 2
+        case 0xFF16: APU->Pulse.NR21 = value; break;
+        case 0xFF17: APU->Pulse.NR22 = value; break;
+        case 0xFF18: APU->Pulse.NR23 = value; break;
+        case 0xFF19:
+            APU->Pulse.NR24 = value;
+            if (value & 0x80) APUPulseTrigger(APU, MMU);
+            break;
+
+        // Channel 3
+        case 0xFF1A: APU->Wave.NR30 = value; break;
+        case 0xFF1B: APU->Wave.NR31 = value; break;
+        case 0xFF1C: APU->Wave.NR32 = value; break;
+        case 0xFF1D: APU->Wave.NR33 = value; break;
+        case 0xFF1E:
+            APU->Wave.NR34 = value;
+            if (value & 0x80) APUWaveTrigger(APU, MMU);
+            break;
+
+        // Channel 4
+        case 0xFF20: APU->Noise.NR41 = value; break;
+        case 0xFF21: APU->Noise.NR42 = value; break;
+        case 0xFF22: APU->Noise.NR43 = value; break;
+        case 0xFF23:
+            APU->Noise.NR44 = value;
+            if (value & 0x80) APUNoiseTrigger(APU, MMU);
+            break;
+
+        case 0xFF24: APU->NR50 = value; break;
+        case 0xFF25: APU->NR51 = value; break;
+        case 0xFF26:
+            APU->NR52 = value;
+            if ((value & 0x80) == 0) {
+                APUInit(APU, MMU); //Powering off resets every register (This emulator then powers it straight back on)
+            }
+            break;
+
+        default:
+            if (address >= 0xFF30) {
+                APU->Wave.WavePatternRAM[address - 0xFF30] = value;
+            }
+            break;
+    }
+    //NR50 and NR51 take effect straight away, everything else from the channel's next step.
+    if (address == 0xFF24 || address == 0xFF25 || address == 0xFF26) {
+        APUUpdateLevels(APU, APU->BlipTime);
+    }
+}
+
 void APULengthCLK(APU *APU, MMU *MMU) {
     if ((APU->PulseWithSweep.NR14 & 0x40) && APU->PulseWithSweep.LengthCounter > 0) {
         APU->PulseWithSweep.LengthCounter--;
@@ -198,17 +231,27 @@ void APUEnvelopeCLK(APU *APU, MMU *MMU) {
     }
 }
 
-void APUPulseWithSweepTick(APU *APU, MMU *MMU) {
+//Counts a channel timer down by Ticks, reloading it with Period whenever it runs out. Returns how many times it ran out.
+static int APUClockTimer(int *Timer, int Period, int Ticks) {
+    int Needed = (*Timer > 1) ? *Timer : 1;
+    if (Ticks < Needed) {
+        *Timer -= Ticks;
+        return 0;
+    }
+    Ticks -= Needed;
+    *Timer = Period - (Ticks % Period);
+    return 1 + (Ticks / Period);
+}
+
+//The channel tick functions run Ticks ticks at once, the registers can't change in between.
+void APUPulseWithSweepTick(APU *APU, MMU *MMU, int Ticks) {
     if (!APU->PulseWithSweep.ChannelOn) {
         APU->PulseWithSweep.Sample = 0;
         return;
     }
-    APU->PulseWithSweep.Timer--;
-    if (APU->PulseWithSweep.Timer <= 0) {
-        uint16_t freq = APU->PulseWithSweep.NR13 | ((APU->PulseWithSweep.NR14 & 0x07) << 8);
-        APU->PulseWithSweep.Timer = (2048 - freq) * 4;
-        APU->PulseWithSweep.DutyStep = (APU->PulseWithSweep.DutyStep + 1) & 7;
-    }
+    uint16_t freq = APU->PulseWithSweep.NR13 | ((APU->PulseWithSweep.NR14 & 0x07) << 8);
+    int Steps = APUClockTimer(&APU->PulseWithSweep.Timer, (2048 - freq) * 4, Ticks);
+    APU->PulseWithSweep.DutyStep = (APU->PulseWithSweep.DutyStep + Steps) & 7;
     uint8_t duty = (APU->PulseWithSweep.NR11 >> 6) & 0x03;
     if (DutyCycles[duty][APU->PulseWithSweep.DutyStep]) {
         APU->PulseWithSweep.Sample = APU->PulseWithSweep.Volume;
@@ -217,17 +260,14 @@ void APUPulseWithSweepTick(APU *APU, MMU *MMU) {
     }
 }
 
-void APUPulseTick(APU *APU, MMU *MMU) {
+void APUPulseTick(APU *APU, MMU *MMU, int Ticks) {
     if (!APU->Pulse.ChannelOn) {
         APU->Pulse.Sample = 0;
         return;
     }
-    APU->Pulse.Timer--;
-    if (APU->Pulse.Timer <= 0) {
-        uint16_t freq = APU->Pulse.NR23 | ((APU->Pulse.NR24 & 0x07) << 8);
-        APU->Pulse.Timer = (2048 - freq) * 4;
-        APU->Pulse.DutyStep = (APU->Pulse.DutyStep + 1) & 7;
-    }
+    uint16_t freq = APU->Pulse.NR23 | ((APU->Pulse.NR24 & 0x07) << 8);
+    int Steps = APUClockTimer(&APU->Pulse.Timer, (2048 - freq) * 4, Ticks);
+    APU->Pulse.DutyStep = (APU->Pulse.DutyStep + Steps) & 7;
     uint8_t duty = (APU->Pulse.NR21 >> 6) & 0x03;
     if (DutyCycles[duty][APU->Pulse.DutyStep]) {
         APU->Pulse.Sample = APU->Pulse.Volume;
@@ -236,17 +276,14 @@ void APUPulseTick(APU *APU, MMU *MMU) {
     }
 }
 
-void APUWaveTick(APU *APU, MMU *MMU) {
+void APUWaveTick(APU *APU, MMU *MMU, int Ticks) {
     if (!APU->Wave.ChannelOn || !(APU->Wave.NR30 & 0x80)) {
         APU->Wave.Sample = 0;
         return;
     }
-    APU->Wave.Timer--;
-    if (APU->Wave.Timer <= 0) {
-        uint16_t freq = APU->Wave.NR33 | ((APU->Wave.NR34 & 0x07) << 8);
-        APU->Wave.Timer = (2048 - freq) * 2;
-        APU->Wave.Position = (APU->Wave.Position + 1) & 31;
-    }
+    uint16_t freq = APU->Wave.NR33 | ((APU->Wave.NR34 & 0x07) << 8);
+    int Steps = APUClockTimer(&APU->Wave.Timer, (2048 - freq) * 2, Ticks);
+    APU->Wave.Position = (APU->Wave.Position + Steps) & 31;
     uint8_t byteVal = APU->Wave.WavePatternRAM[APU->Wave.Position / 2];
     uint8_t sampleVal = (APU->Wave.Position & 1) ? (byteVal & 0x0F) : (byteVal >> 4);
     uint8_t volumeCode = (APU->Wave.NR32 >> 5) & 0x03;
@@ -258,17 +295,16 @@ void APUWaveTick(APU *APU, MMU *MMU) {
     }
 }
 
-void APUNoiseTick(APU *APU, MMU *MMU) {
+void APUNoiseTick(APU *APU, MMU *MMU, int Ticks) {
     if (!APU->Noise.ChannelOn) {
         APU->Noise.Sample = 0;
         return;
     }
-    APU->Noise.Timer--;
-    if (APU->Noise.Timer <= 0) {
-        uint8_t shift = (APU->Noise.NR43 >> 4) & 0x0F;
-        uint8_t divisor = APU->Noise.NR43 & 0x07;
-        APU->Noise.Timer = (NoiseDivisors[divisor] << shift);
+    uint8_t shift = (APU->Noise.NR43 >> 4) & 0x0F;
+    uint8_t divisor = APU->Noise.NR43 & 0x07;
+    int Steps = APUClockTimer(&APU->Noise.Timer, (NoiseDivisors[divisor] << shift), Ticks);
 
+    for (int i = 0; i < Steps; i++) {
         uint16_t lfsr = APU->Noise.LSFR;
         uint8_t result = (lfsr & 1) ^ ((lfsr >> 1) & 1);
         lfsr >>= 1;
@@ -336,70 +372,147 @@ void APUNoiseTrigger(APU *APU, MMU *MMU) {
     APU->Noise.LSFR = 0x7FFF;
 }
 
-void APUTick(APU *APU, MMU *MMU) {
-    APUUpdate(APU, MMU);
+//Channel tick functions in channel order (Pulse with sweep, Pulse, Wave, Noise), for running them one at a time.
+typedef void (*APUChannelTick)(APU *APU, MMU *MMU, int Ticks);
+static const APUChannelTick APUChannelTicks[4] = {APUPulseWithSweepTick, APUPulseTick, APUWaveTick, APUNoiseTick};
 
-    if ((APU->NR52 & 0x80) == 0) {
-        APUInit(APU, MMU);
-        return;
+static int APUChannelSample(APU *APU, int Channel) {
+    switch (Channel) {
+        case 0: return APU->PulseWithSweep.Sample;
+        case 1: return APU->Pulse.Sample;
+        case 2: return APU->Wave.Sample;
+        default: return APU->Noise.Sample;
     }
+}
 
-    if (APU->FrameSequencerCounter <= 0) {
-        APU->FrameSequencerCounter = 8192;
-        switch (APU->FrameSequencerStep) {
-            case 0: case 4: APULengthCLK(APU, MMU); break;
-            case 2: case 6: APUSweepCLK(APU, MMU); APULengthCLK(APU, MMU); break;
-            case 7: APUEnvelopeCLK(APU, MMU); break;
-        }
-        APU->FrameSequencerStep = (APU->FrameSequencerStep + 1) & 7;
-    } else {
-        APU->FrameSequencerCounter--;
+//Ticks until the channel's timer next runs out, the only time its output can change by itself (0 if the timer isn't running).
+static int APUChannelNextStep(APU *APU, int Channel) {
+    int Timer;
+    switch (Channel) {
+        case 0: if (!APU->PulseWithSweep.ChannelOn) return 0; Timer = APU->PulseWithSweep.Timer; break;
+        case 1: if (!APU->Pulse.ChannelOn) return 0; Timer = APU->Pulse.Timer; break;
+        case 2: if (!APU->Wave.ChannelOn || !(APU->Wave.NR30 & 0x80)) return 0; Timer = APU->Wave.Timer; break;
+        default: if (!APU->Noise.ChannelOn) return 0; Timer = APU->Noise.Timer; break;
     }
+    return (Timer > 1) ? Timer : 1;
+}
 
-    APUPulseWithSweepTick(APU, MMU);
-    APUPulseTick(APU, MMU);
-    APUWaveTick(APU, MMU);
-    APUNoiseTick(APU, MMU);
+//Puts the channel's current output through NR51 and NR50, and records any change in its left/right level at Time.
+static void APUUpdateLevel(APU *APU, int Channel, uint32_t Time) {
+    if (APU->Muted) {
+        return; //Caught up by the first update after unmuting
+    }
+    int Sample = APUChannelSample(APU, Channel);
+    int Left = (APU->NR51 & (0x10 << Channel)) ? Sample * (APU->NR50 & 0x07) * 120 : 0;
+    int Right = (APU->NR51 & (0x01 << Channel)) ? Sample * ((APU->NR50 & 0x70) >> 4) * 120 : 0;
 
-    // Mixer
-    APU->MasterSampleLeft = 0;
-    APU->MasterSampleRight = 0;
+    if (Left != APU->Level[Channel][0]) {
+        BlipAddDelta(&APU->Output, 0, Time, Left - APU->Level[Channel][0]);
+        APU->Level[Channel][0] = Left;
+    }
+    if (Right != APU->Level[Channel][1]) {
+        BlipAddDelta(&APU->Output, 1, Time, Right - APU->Level[Channel][1]);
+        APU->Level[Channel][1] = Right;
+    }
+}
 
-    if (APU->NR51 & 0x10) APU->MasterSampleLeft += APU->PulseWithSweep.Sample;
-    if (APU->NR51 & 0x01) APU->MasterSampleRight += APU->PulseWithSweep.Sample;
+void APUUpdateLevels(APU *APU, uint32_t Time) {
+    for (int Channel = 0; Channel < 4; Channel++) {
+        APUUpdateLevel(APU, Channel, Time);
+    }
+}
 
-    if (APU->NR51 & 0x20) APU->MasterSampleLeft += APU->Pulse.Sample;
-    if (APU->NR51 & 0x02) APU->MasterSampleRight += APU->Pulse.Sample;
+//Runs one channel for Ticks ticks, stopping every time its timer runs out so each change in its output lands on the tick it happened.
+static void APURunChannel(APU *APU, MMU *MMU, int Channel, int Ticks) {
+    int Done = 0;
+    while (Done < Ticks) {
+        int Step = Ticks - Done;
+        int Next = APUChannelNextStep(APU, Channel);
+        if (Next > 0 && Next < Step) {
+            Step = Next;
+        }
+        APUChannelTicks[Channel](APU, MMU, Step);
+        Done += Step;
+        APUUpdateLevel(APU, Channel, APU->BlipTime + Done);
+    }
+}
 
-    if (APU->NR51 & 0x40) APU->MasterSampleLeft += APU->Wave.Sample;
-    if (APU->NR51 & 0x04) APU->MasterSampleRight += APU->Wave.Sample;
+//Runs every channel for Ticks ticks. Muted, nothing needs to be recorded so each channel does the whole stretch at once.
+static void APURunChannels(APU *APU, MMU *MMU, int Ticks) {
+    for (int Channel = 0; Channel < 4; Channel++) {
+        if (APU->Muted) {
+            APUChannelTicks[Channel](APU, MMU, Ticks);
+        }
+        else {
+            APURunChannel(APU, MMU, Channel, Ticks);
+        }
+    }
+}
 
-    if (APU->NR51 & 0x80) APU->MasterSampleLeft += APU->Noise.Sample;
-    if (APU->NR51 & 0x08) APU->MasterSampleRight += APU->Noise.Sample;
+void APUInitOutput(APU *APU, double Rate) {
+    BlipInit(&APU->Output, Rate);
+    APU->BlipTime = 0;
+    memset(APU->Level, 0, sizeof(APU->Level));
+}
 
-    // Downsampling to 44.1 kHz (~95 T-cycles per sample)
-    APU->SampleTimer++;
-    if (APU->SampleTimer >= 95) {
-        APU->SampleTimer = 0;
-        SDLPlayAudio(APU, MMU);
+void APUEndFrame(APU *APU) {
+    if (!APU->Muted) {
+        BlipEndFrame(&APU->Output, APU->BlipTime);
     }
+    APU->BlipTime = 0;
 }
 
-void SDLPlayAudio(APU *APU, MMU *MMU) {
-    int leftVol = (APU->NR50 & 0x07);
-    int rightVol = (APU->NR50 & 0x70) >> 4;
+/*Runs the APU for the given number of ticks.
+  Register writes reach the APU through APUWriteRegister as they happen, so there is nothing to read back from the MMU here.
+  Between frame sequencer steps only the channel timers move, so those stretches are done in one go, with each channel stopping only where its output can change. */
+void APUAdvance(APU *APU, MMU *MMU, int Ticks) {
+    while (Ticks > 0) {
+        if (APU->BlipTime >= APU_BLIP_FRAME) {
+            APUEndFrame(APU);
+        }
+        if (APU->FrameSequencerCounter <= 0) {
+            APUStep(APU, MMU);
+            Ticks--;
+            continue;
+        }
+
+        int Run = Ticks;
+        if (Run > APU->FrameSequencerCounter) Run = APU->FrameSequencerCounter;
+        if (Run > APU_BLIP_FRAME - (int)APU->BlipTime) Run = APU_BLIP_FRAME - APU->BlipTime;
+        APU->FrameSequencerCounter -= Run;
 
-    int16_t leftPcm = (int16_t)(APU->MasterSampleLeft * leftVol * 120);
-    int16_t rightPcm = (int16_t)(APU->MasterSampleRight * rightVol * 120);
+        APURunChannels(APU, MMU, Run);
+        APU->BlipTime += Run;
+        Ticks -= Run;
+    }
+}
+
+//Ticks until the next frame sequencer step (0 means the very next tick). Nothing the CPU can read changes in between.
+int APUNextEvent(APU *APU, MMU *MMU) {
+    if (APU->FrameSequencerCounter <= 0) {
+        return 0;
+    }
+    return APU->FrameSequencerCounter;
+}
 
-    APU->AudioBuffer[APU->CurrentSample * 2] = leftPcm;
-    APU->AudioBuffer[APU->CurrentSample * 2 + 1] = rightPcm;
-    APU->CurrentSample++;
+//One tick of the frame sequencer and channels.
+void APUStep(APU *APU, MMU *MMU) {
+    if (APU->BlipTime >= APU_BLIP_FRAME) {
+        APUEndFrame(APU);
+    }
 
-    if (APU->CurrentSample >= 512) {
-        if (SDL_GetQueuedAudioSize(audioDevice) < 8192) {
-            SDL_QueueAudio(audioDevice, APU->AudioBuffer, sizeof(int16_t) * 1024);
+    if (APU->FrameSequencerCounter <= 0) {
+        APU->FrameSequencerCounter = 8192;
+        switch (APU->FrameSequencerStep) {
+            case 0: case 4: APULengthCLK(APU, MMU); break;
+            case 2: case 6: APUSweepCLK(APU, MMU); APULengthCLK(APU, MMU); break;
+            case 7: APUEnvelopeCLK(APU, MMU); break;
         }
-        APU->CurrentSample = 0;
+        APU->FrameSequencerStep = (APU->FrameSequencerStep + 1) & 7;
+    } else {
+        APU->FrameSequencerCounter--;
     }
-}
\ No newline at end of file
+
+    APURunChannels(APU, MMU, 1);
+    APU->BlipTime++;
+}
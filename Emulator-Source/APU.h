@@ -3,8 +3,13 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#ifndef HEADLESS
 #include <SDL2/SDL.h>
+#endif
 #include "MMU.h"
+#include "Blip.h"
+
+#define APU_BLIP_FRAME 8192 //Most ticks the APU runs before handing its deltas over to the blip buffer
 
 typedef struct {
     uint8_t NR10;
@@ -107,27 +112,32 @@ typedef struct {
     uint8_t NR50;
     uint8_t NR51;
     uint8_t NR52;
-    //Master Audio Sample
-    int16_t MasterSampleRight;
-    int16_t MasterSampleLeft;
     int FrameSequencerStep;
     int FrameSequencerCounter;
-    int CurrentSample;
-    int SampleTimer;
-    int16_t AudioBuffer[2048]; // Stereo PCM buffer
     int Ticks;
+    int Muted; //Set while fast forwarding, the channels keep running but nothing gets recorded or output
+    //Output, every change in a channel's level goes into the blip buffer, which DMGGetAudio reads samples out of.
+    Blip Output;
+    uint32_t BlipTime; //Ticks since the blip buffer's frame started
+    int Level[4][2]; //Left and right level each channel was last recorded at (Sample routed through NR51 and scaled by NR50)
 } APU;
 
 //Main Functions
 void APUInit(APU *APU, MMU *MMU);
-void APUTick(APU *APU, MMU *MMU);
-void APUUpdate(APU *APU, MMU *MMU);
+void APUAdvance(APU *APU, MMU *MMU, int Ticks); //Runs Ticks worth of APUStep.
+void APUStep(APU *APU, MMU *MMU);
+int APUNextEvent(APU *APU, MMU *MMU); //Ticks until the next frame sequencer step, for the scheduler.
+void APULoadRegisters(APU *APU, MMU *MMU); //Copies the sound registers out of SystemMemory, without triggering anything.
+void APUWriteRegister(APU *APU, MMU *MMU, uint16_t address, uint8_t value); //Handles a CPU write to 0xFF10-0xFF3F, through MMU->SoundWrite.
+void APUInitOutput(APU *APU, double Rate); //Clears the output, kept out of APUInit since that also runs whenever the game powers the APU off.
+void APUEndFrame(APU *APU); //Makes the samples up to the APU's current tick readable from Output.
+void APUUpdateLevels(APU *APU, uint32_t Time); //Records any change in the channels' output levels at Time (Ticks into the blip frame).
 
 //Tick Channel Functions
-void APUPulseWithSweepTick(APU *APU, MMU *MMU);
-void APUPulseTick(APU *APU, MMU *MMU);
-void APUWaveTick(APU *APU, MMU *MMU);
-void APUNoiseTick(APU *APU, MMU *MMU);
+void APUPulseWithSweepTick(APU *APU, MMU *MMU, int Ticks);
+void APUPulseTick(APU *APU, MMU *MMU, int Ticks);
+void APUWaveTick(APU *APU, MMU *MMU, int Ticks);
+void APUNoiseTick(APU *APU, MMU *MMU, int Ticks);
 
 //Length CLK, Sweep CLK, and Envelope CLK
 void APULengthCLK(APU *APU, MMU *MMU);
@@ -140,8 +150,5 @@ void APUPulseTrigger(APU *APU, MMU *MMU);
 void APUWaveTrigger(APU *APU, MMU *MMU);
 void APUNoiseTrigger(APU *APU, MMU *MMU);
 
-//SDL Audio Functions
-void SDLPlayAudio(APU *APU, MMU *MMU);
-
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <string.h>
+#include "Audio.h"
+
+#ifndef HEADLESS
+extern SDL_AudioSpec audio;
+extern SDL_AudioSpec audio2;
+extern SDL_AudioDeviceID audioDevice;
+
+//SDL audio thread, copies out as many frames as the ring has and fills the rest with silence.
+static void AudioCallback(void *Data, Uint8 *Stream, int Length) {
+    Audio *Sound = (Audio *)Data;
+    int16_t *Out = (int16_t *)Stream;
+    int Frames = Length / (int)(sizeof(int16_t) * 2);
+
+    uint32_t Read = (uint32_t)SDL_AtomicGet(&Sound->ReadPosition);
+    uint32_t Available = (uint32_t)SDL_AtomicGet(&Sound->WritePosition) - Read;
+
+    //After running dry, wait for the ring to refill so it doesn't stutter along at the edge.
+    if (Sound->Priming) {
+        if (Available < AUDIO_TARGET_FILL) {
+            memset(Stream, 0, Length);
+            return;
+        }
+        Sound->Priming = 0;
+    }
+
+    int Count = (Available < (uint32_t)Frames) ? (int)Available : Frames;
+    for (int i = 0; i < Count; i++) {
+        uint32_t Index = (Read + i) & (AUDIO_RING_FRAMES - 1);
+        Out[i * 2] = Sound->Ring[Index * 2];
+        Out[i * 2 + 1] = Sound->Ring[Index * 2 + 1];
+    }
+    if (Count < Frames) {
+        memset(Out + Count * 2, 0, (Frames - Count) * sizeof(int16_t) * 2);
+        Sound->Priming = 1;
+    }
+    SDL_AtomicSet(&Sound->ReadPosition, (int)(Read + Count));
+}
+
+int AudioInit(Audio *Audio) {
+    SDL_AtomicSet(&Audio->ReadPosition, 0);
+    SDL_AtomicSet(&Audio->WritePosition, 0);
+    Audio->Priming = 1;
+    Audio->Frequency = AUDIO_RATE;
+
+    audio.freq = AUDIO_RATE;
+    audio.format = AUDIO_S16SYS;
+    audio.channels = 2;
+    audio.samples = 512; //Callback size, the latency comes from the ring fill on top of this
+    audio.callback = AudioCallback;
+    audio.userdata = Audio;
+
+    //Only the frequency is allowed to change, the ring is always 16 bit stereo.
+    audioDevice = SDL_OpenAudioDevice(NULL, 0, &audio, &audio2, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+    if (audioDevice == 0) {
+        printf("Error: Could not open the audio device (%s)\n", SDL_GetError());
+        return -1;
+    }
+    Audio->Frequency = audio2.freq;
+
+    SDL_PauseAudioDevice(audioDevice, 0);
+    return 0;
+}
+
+void AudioClose(Audio *Audio) {
+    if (audioDevice != 0) {
+        SDL_CloseAudioDevice(audioDevice);
+        audioDevice = 0;
+    }
+}
+
+void AudioPush(Audio *Audio, const int16_t *Samples, int Frames) {
+    uint32_t Write = (uint32_t)SDL_AtomicGet(&Audio->WritePosition);
+    uint32_t Free = AUDIO_RING_FRAMES - (Write - (uint32_t)SDL_AtomicGet(&Audio->ReadPosition));
+
+    if ((uint32_t)Frames > Free) {
+        Frames = (int)Free;
+    }
+    for (int i = 0; i < Frames; i++) {
+        uint32_t Index = (Write + i) & (AUDIO_RING_FRAMES - 1);
+        Audio->Ring[Index * 2] = Samples[i * 2];
+        Audio->Ring[Index * 2 + 1] = Samples[i * 2 + 1];
+    }
+    //Published after the samples are in, SDL_AtomicSet is a full barrier.
+    SDL_AtomicSet(&Audio->WritePosition, (int)(Write + Frames));
+}
+
+double AudioRate(Audio *Audio) {
+    uint32_t Fill = (uint32_t)SDL_AtomicGet(&Audio->WritePosition) - (uint32_t)SDL_AtomicGet(&Audio->ReadPosition);
+
+    //Fuller than the target makes fewer samples per frame, emptier makes more, scaled linearly up to AUDIO_MAX_ADJUST.
+    double Error = ((double)Fill - AUDIO_TARGET_FILL) / AUDIO_TARGET_FILL;
+    if (Error > 1.0) {
+        Error = 1.0;
+    }
+    if (Error < -1.0) {
+        Error = -1.0;
+    }
+    return Audio->Frequency * (1.0 - AUDIO_MAX_ADJUST * Error);
+}
+#endif
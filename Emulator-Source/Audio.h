@@ -0,0 +1,36 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#ifndef HEADLESS
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+/*
+    Audio (Ring buffer feeding the SDL audio callback)
+    The emulation thread pushes every sample the APU makes into a single producer, single consumer ring, and SDL's audio thread pulls them
+    out from its callback. Each side only ever moves its own position, so neither needs a lock.
+    The Game Boy's clock and the sound card's never quite agree, so after every frame the emulation thread asks for a slightly different
+    output rate (At most 0.5% either way) depending on how full the ring is. That keeps the fill near AUDIO_TARGET_FILL, which bounds the
+    latency, without the ring ever running dry or overflowing (Unless the emulation itself stops keeping up).
+*/
+#define AUDIO_RATE 44100
+#define AUDIO_RING_FRAMES 8192 //Stereo frames, has to be a power of two
+#define AUDIO_TARGET_FILL 2048 //Frames the rate control aims to keep queued (~46 ms)
+#define AUDIO_MAX_ADJUST 0.005 //Largest change to the output rate, 0.5% is too small to hear as a pitch change
+
+typedef struct {
+    int16_t Ring[AUDIO_RING_FRAMES * 2];
+    SDL_atomic_t ReadPosition; //Frames taken out by the callback so far (Wraps, only the callback moves it)
+    SDL_atomic_t WritePosition; //Frames pushed by the emulation thread so far (Wraps, only the emulation thread moves it)
+
+    int Frequency; //Rate the device actually opened with
+    int Priming; //Callback only, plays silence until the ring fills back up after running dry
+} Audio;
+
+int AudioInit(Audio *Audio); //Opens the audio device with the ring as its source, returns -1 if there is no audio.
+void AudioClose(Audio *Audio);
+void AudioPush(Audio *Audio, const int16_t *Samples, int Frames); //Emulation thread, queues interleaved stereo frames (Whatever doesn't fit is dropped).
+double AudioRate(Audio *Audio); //Emulation thread, the rate the APU should output at right now to keep the ring near AUDIO_TARGET_FILL.
+
+#endif
+#endif // AUDIO_H
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "Blip.h"
+
+#define BLIP_BUFFER_LENGTH (BLIP_SIZE + BLIP_MARGIN + BLIP_WIDTH)
+#define BLIP_CUTOFF 0.9 //Fraction of the output's Nyquist frequency the steps are band-limited to
+
+//Windowed sinc impulse for every phase, each phase sums to exactly 1 << BLIP_UNIT_BITS so a step always settles on the right level.
+static int32_t BlipKernel[BLIP_PHASES][BLIP_WIDTH];
+static int BlipKernelReady = 0;
+
+static void BlipMakeKernel(void) {
+    const double Pi = 3.14159265358979323846;
+
+    for (int Phase = 0; Phase < BLIP_PHASES; Phase++) {
+        double Taps[BLIP_WIDTH];
+        double Total = 0;
+        for (int k = 0; k < BLIP_WIDTH; k++) {
+            //Distance in samples from the step's exact position, which lies Phase / BLIP_PHASES past tap BLIP_WIDTH / 2.
+            double t = (k - BLIP_WIDTH / 2) - (double)Phase / BLIP_PHASES;
+            double x = BLIP_CUTOFF * t;
+            double Sinc = (x == 0) ? 1.0 : sin(Pi * x) / (Pi * x);
+            double Window = 0;
+            if (fabs(t) < BLIP_WIDTH / 2) { //Blackman
+                Window = 0.42 + 0.5 * cos(2 * Pi * t / BLIP_WIDTH) + 0.08 * cos(4 * Pi * t / BLIP_WIDTH);
+            }
+            Taps[k] = Sinc * Window;
+            Total += Taps[k];
+        }
+
+        //Scale to the unit and put the rounding error on the centre tap.
+        int32_t Sum = 0;
+        for (int k = 0; k < BLIP_WIDTH; k++) {
+            BlipKernel[Phase][k] = (int32_t)floor(Taps[k] / Total * (1 << BLIP_UNIT_BITS) + 0.5);
+            Sum += BlipKernel[Phase][k];
+        }
+        BlipKernel[Phase][BLIP_WIDTH / 2] += (1 << BLIP_UNIT_BITS) - Sum;
+    }
+    BlipKernelReady = 1;
+}
+
+void BlipInit(Blip *Blip, double Rate) {
+    if (!BlipKernelReady) {
+        BlipMakeKernel();
+    }
+    memset(Blip->Buffer, 0, sizeof(Blip->Buffer));
+    Blip->Sum[0] = 0;
+    Blip->Sum[1] = 0;
+    Blip->Offset = 0;
+    BlipSetRate(Blip, Rate);
+}
+
+void BlipSetRate(Blip *Blip, double Rate) {
+    Blip->Factor = (uint64_t)(Rate / 4194304.0 * 4294967296.0 + 0.5);
+}
+
+void BlipAddDelta(Blip *Blip, int Channel, uint32_t Time, int Delta) {
+    uint64_t Position = Blip->Offset + Time * Blip->Factor;
+    uint32_t Index = (uint32_t)(Position >> 32);
+    const int32_t *Kernel = BlipKernel[(Position >> (32 - BLIP_PHASE_BITS)) & (BLIP_PHASES - 1)];
+
+    if (Index + BLIP_WIDTH > BLIP_BUFFER_LENGTH) {
+        return; //Only if the frame ran past BLIP_MARGIN
+    }
+    int32_t *Out = Blip->Buffer[Channel] + Index;
+    for (int k = 0; k < BLIP_WIDTH; k++) {
+        Out[k] += Kernel[k] * Delta;
+    }
+}
+
+//Integrates Count samples and moves everything after them to the front, writing them out if Samples isn't NULL.
+static void BlipTake(Blip *Blip, int16_t *Samples, int Count) {
+    for (int Channel = 0; Channel < 2; Channel++) {
+        int32_t *Buffer = Blip->Buffer[Channel];
+        int64_t Sum = Blip->Sum[Channel];
+        for (int i = 0; i < Count; i++) {
+            Sum += Buffer[i];
+            int64_t Sample = Sum >> BLIP_UNIT_BITS;
+            Sum -= Sum >> BLIP_BASS_SHIFT;
+            if (Samples != NULL) {
+                Samples[i * 2 + Channel] = (int16_t)((Sample > 32767) ? 32767 : (Sample < -32768) ? -32768 : Sample);
+            }
+        }
+        Blip->Sum[Channel] = Sum;
+        memmove(Buffer, Buffer + Count, sizeof(int32_t) * (BLIP_BUFFER_LENGTH - Count));
+        memset(Buffer + BLIP_BUFFER_LENGTH - Count, 0, sizeof(int32_t) * Count);
+    }
+    Blip->Offset -= (uint64_t)Count << 32;
+}
+
+void BlipEndFrame(Blip *Blip, uint32_t Time) {
+    Blip->Offset += Time * Blip->Factor;
+
+    //Nobody is reading, keep the newest samples.
+    int Available = BlipSamplesAvailable(Blip);
+    if (Available > BLIP_SIZE) {
+        BlipTake(Blip, NULL, Available - BLIP_SIZE);
+    }
+}
+
+int BlipSamplesAvailable(Blip *Blip) {
+    return (int)(Blip->Offset >> 32);
+}
+
+int BlipRead(Blip *Blip, int16_t *Samples, int MaxFrames) {
+    int Count = BlipSamplesAvailable(Blip);
+    if (Count > MaxFrames) {
+        Count = MaxFrames;
+    }
+    if (Count > 0) {
+        BlipTake(Blip, Samples, Count);
+    }
+    return Count;
+}
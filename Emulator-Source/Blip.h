@@ -0,0 +1,38 @@
+#ifndef BLIP_H
+#define BLIP_H
+
+#include <stdint.h>
+
+/*
+    Blip Buffer (Band-limited step synthesis)
+    The channels only ever output flat levels that jump from one value to another, so instead of sampling them every tick the APU records
+    each jump (delta) with the tick it happened on. Every jump is added to the output as a band-limited step: a windowed sinc impulse placed at
+    the exact fractional sample position, which gets turned back into a step when the buffer is read out (running sum).
+    Nothing above the output's Nyquist frequency makes it through, so there is no aliasing, and the cost depends on how often the
+    channels change instead of how many ticks go by.
+    Reading also leaks the running sum a little each sample, which works as a high-pass filter (Like the Game Boy's output capacitor) and
+    keeps the unsigned channel levels centred on zero.
+*/
+#define BLIP_PHASE_BITS 5
+#define BLIP_PHASES (1 << BLIP_PHASE_BITS) //Fractional sample positions a step can be placed at
+#define BLIP_WIDTH 16 //Taps per step, the output is delayed by half of this
+#define BLIP_UNIT_BITS 14 //A delta of 1 adds up to 1 << BLIP_UNIT_BITS in the buffer
+#define BLIP_BASS_SHIFT 9 //High-pass strength, the running sum loses 1/512 of itself per sample (~14 Hz at 44.1 kHz)
+#define BLIP_SIZE 4096 //Samples it holds before the oldest get dropped
+#define BLIP_MARGIN 256 //Room for one frame of samples past BLIP_SIZE (A frame is at most 8192 ticks)
+
+typedef struct {
+    int32_t Buffer[2][BLIP_SIZE + BLIP_MARGIN + BLIP_WIDTH]; //Left and right deltas, index 0 is the oldest sample not read yet
+    int64_t Sum[2]; //Running sum (the current level) at the read position
+    uint64_t Offset; //Where tick 0 of the current frame falls, in samples past index 0 (32.32 fixed point)
+    uint64_t Factor; //Output samples per tick (32.32 fixed point)
+} Blip;
+
+void BlipInit(Blip *Blip, double Rate); //Clears the buffer, Rate is in samples per second.
+void BlipSetRate(Blip *Blip, double Rate); //Only call between frames.
+void BlipAddDelta(Blip *Blip, int Channel, uint32_t Time, int Delta); //Channel 0 is left and 1 is right, Time is in ticks since the frame started.
+void BlipEndFrame(Blip *Blip, uint32_t Time); //Ends the frame Time ticks in, the samples before that can be read out.
+int BlipSamplesAvailable(Blip *Blip);
+int BlipRead(Blip *Blip, int16_t *Samples, int MaxFrames); //Reads up to MaxFrames interleaved stereo frames, returns how many were read.
+
+#endif // BLIP_H
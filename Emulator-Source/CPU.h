@@ -4,6 +4,17 @@
 #include <stdint.h> 
 #include "MMU.h"
 
+//Which kind of ALU operation the lazy flags were left by. (ADC/SBC/CP share ADD/SUB, XOR shares OR)
+enum {
+    FLAGS_NONE,
+    FLAGS_ADD,
+    FLAGS_SUB,
+    FLAGS_AND,
+    FLAGS_OR,
+    FLAGS_INC,
+    FLAGS_DEC
+};
+
 typedef struct {
     //Registers
     uint8_t RegA;
@@ -21,6 +32,14 @@ typedef struct {
     uint16_t SP;
     uint16_t PC;
 
+    //Lazy Flags
+    //8-bit ALU instructions only record what they did, RegF is rebuilt from this once something reads it (See CPUGetFlags).
+    uint8_t FlagOp; //FLAGS_NONE when RegF is up to date
+    uint8_t FlagX; //Left operand (A, or the value for INC/DEC)
+    uint8_t FlagY; //Right operand
+    uint8_t FlagCarry; //Carry in for ADC/SBC
+    uint8_t FlagResult; //8-bit result, enough on its own for the Zero Flag
+
     // Flags
     uint8_t HALT;
     uint8_t IME; // Interrupt Master Enable Flag
@@ -32,11 +51,18 @@ typedef struct {
 
 void CPUInit(CPU *CPU);
 void CPUTick(CPU *CPU, MMU *MMU);
-uint8_t CPUExecuteInstruction(CPU *CPU, MMU *MMU);
+uint8_t CPUStep(CPU *CPU, MMU *MMU);
+uint8_t CPUExecuteInstruction(CPU *CPU, MMU *MMU); //Default dispatcher (The function pointer table)
 uint8_t CPUExecuteCB(CPU *CPU, MMU *MMU);
+uint8_t CPUGetFlags(CPU *CPU); //Brings RegF up to date with the lazy flags and returns it, use this instead of reading RegF directly.
+
+//The three dispatchers, all run the same handlers. (Compared by --bench-dispatch)
+uint8_t CPUExecuteSwitch(CPU *CPU, MMU *MMU);
+uint8_t CPUExecuteTable(CPU *CPU, MMU *MMU);
+uint8_t CPUExecuteGoto(CPU *CPU, MMU *MMU);
 
 //Gameboy Doctor Log
-void CPULOG(CPU *CPU, MMU *MMU);
+void CPULOG(CPU *CPU, MMU *MMU, uint64_t Cycle); //Cycle is the tick the instruction starts on
 void CPUPrint(CPU *CPU, MMU *MMU);
 
 #endif 
\ No newline at end of file
@@ -1,43 +1,169 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <SDL2/SDL.h>
+#include <string.h>
+#include <time.h>
 #include "DMG.h"
+#include "Hash.h"
 
+#ifndef HEADLESS
 extern SDL_Window *window;
 extern SDL_Renderer *renderer;
 extern SDL_Texture* texture;
-extern SDL_AudioSpec audio;
-extern SDL_AudioSpec audio2;
-extern SDL_AudioDeviceID audioDevice;
+#endif
 
 extern int SCALE;
 extern int TargetFPS;
+extern int Headless;
 
+//T-Cycles in one full frame (154 scanlines of 456 dots)
+#define DMG_FRAME_TICKS 70224
 
-void DMGTick(DMG *DMG) {
-    //M Cycle = 4 Ticks
+//Runs one component from where it was last left up to the given tick.
+static void DMGSyncComponent(DMG *DMG, int Type, uint64_t Time) {
+    Scheduler *Scheduler = &DMG->DMG_Scheduler;
+    if (Time <= Scheduler->SyncedTo[Type]) {
+        return;
+    }
+    int Ticks = (int)(Time - Scheduler->SyncedTo[Type]);
+    Scheduler->SyncedTo[Type] = Time;
 
-    //Tick CPU
-    CPUTick(&DMG->DMG_CPU, &DMG->DMG_MMU);
-    
-    //Update PPU (Later on potentially set rendering to happen after all ticks are done and the system in mode 3 instead of only on a scanline by scanline basis.)
-    PPUTick(&DMG->DMG_PPU, &DMG->DMG_MMU);
-        
-    //Update DMA
-    DMATick(&DMG->DMG_MMU);
-        
-    //Update Timer
-    TimerTick(&DMG->DMG_Timer, &DMG->DMG_MMU);
-        
-    //Update APU (Every 64 Ticks)
-    APUTick(&DMG->DMG_APU, &DMG->DMG_MMU);
+    switch (Type) {
+        case SCHED_PPU: PPUAdvance(&DMG->DMG_PPU, &DMG->DMG_MMU, Ticks); break;
+        case SCHED_TIMER: TimerAdvance(&DMG->DMG_Timer, &DMG->DMG_MMU, Ticks); break;
+        case SCHED_APU: APUAdvance(&DMG->DMG_APU, &DMG->DMG_MMU, Ticks); break;
+    }
 }
 
+//Asks the component when it next needs to run and puts that in the scheduler.
+static void DMGScheduleComponent(DMG *DMG, int Type) {
+    Scheduler *Scheduler = &DMG->DMG_Scheduler;
+    int Ticks = 0;
 
+    switch (Type) {
+        case SCHED_PPU: Ticks = PPUNextEvent(&DMG->DMG_PPU, &DMG->DMG_MMU); break;
+        case SCHED_TIMER: Ticks = TimerNextEvent(&DMG->DMG_Timer, &DMG->DMG_MMU); break;
+        case SCHED_APU: Ticks = APUNextEvent(&DMG->DMG_APU, &DMG->DMG_MMU); break;
+        default: return;
+    }
+    SchedulerSet(Scheduler, Type, Scheduler->SyncedTo[Type] + Ticks);
+}
+
+//Something outside the component changed its registers, so it has to run its next tick for real and work out its next event again.
+static void DMGWakeComponent(DMG *DMG, int Type) {
+    if (Type == SCHED_PPU) {
+        DMG->DMG_PPU.IdleTicks = 0;
+    }
+    SchedulerSet(&DMG->DMG_Scheduler, Type, DMG->DMG_Scheduler.SyncedTo[Type]);
+}
+
+/*MMU write hook, called right before the CPU writes an I/O register (or VRAM, while the PPU has it trapped).
+  The component that reads the register is first run up to the start of the instruction with the old value (like the per tick loop did), then woken up so it picks the new value up right after the instruction.
+  The PPU also draws the pixels it has gone past, since those have to be drawn with the old value too. */
+static void DMGWriteHook(void *Context, uint16_t address) {
+    DMG *Gameboy = (DMG *)Context;
+    int Type;
+
+    if (address == 0xFF07) {
+        Type = SCHED_TIMER; //TAC (DIV, TIMA and TMA writes don't move the next increment)
+    }
+    else if (address >= 0xFF10 && address <= 0xFF3F) {
+        //Sound registers and Wave RAM, the write itself goes to the APU through DMGSoundWrite. Only powering off (NR52) moves the frame sequencer.
+        DMGSyncComponent(Gameboy, SCHED_APU, Gameboy->DMG_Scheduler.Cycle);
+        if (address == 0xFF26) {
+            DMGWakeComponent(Gameboy, SCHED_APU);
+        }
+        return;
+    }
+    else if (address == 0xFF40 || address == 0xFF41 || address == 0xFF44 || address == 0xFF45) {
+        Type = SCHED_PPU; //LCDC, STAT, LY, LYC
+    }
+    else if ((address >= 0xFF42 && address <= 0xFF4B && address != 0xFF46) || (address >= 0x8000 && address <= 0x9FFF)) {
+        //SCY, SCX, the palettes, WY, WX and VRAM are only read while drawing, so the PPU just has to draw up to now. Its next event stays the same.
+        DMGSyncComponent(Gameboy, SCHED_PPU, Gameboy->DMG_Scheduler.Cycle);
+        PPUFlush(&Gameboy->DMG_PPU, &Gameboy->DMG_MMU);
+        return;
+    }
+    else {
+        return;
+    }
+
+    DMGSyncComponent(Gameboy, Type, Gameboy->DMG_Scheduler.Cycle);
+    if (Type == SCHED_PPU) {
+        PPUFlush(&Gameboy->DMG_PPU, &Gameboy->DMG_MMU);
+    }
+    DMGWakeComponent(Gameboy, Type);
+}
+
+//MMU sound write hook, the APU has already been caught up by DMGWriteHook.
+static void DMGSoundWrite(void *Context, uint16_t address, uint8_t value) {
+    DMG *Gameboy = (DMG *)Context;
+    APUWriteRegister(&Gameboy->DMG_APU, &Gameboy->DMG_MMU, address, value);
+}
+
+/*Scheduler based stepping.
+  Runs a whole instruction at once, then only runs the PPU, Timer and APU whose next event came due during it, catching them up to the current tick.
+  Between events a component does nothing the CPU can see, so leaving it behind until then produces the exact same timing as running every component on every tick.
+  Only called on an instruction boundary (MMU->Ticks == 0). */
+int DMGStep(DMG *DMG) {
+    Scheduler *Scheduler = &DMG->DMG_Scheduler;
+    uint64_t Start = Scheduler->Cycle;
+    uint8_t OldIF = DMG->DMG_MMU.SystemMemory[0xFF0F];
+
+    if (DMG->DMG_CPU.LOG == 1 || DMG->DMG_MMU.DEBUGMODE == 1) {
+        CPULOG(&DMG->DMG_CPU, &DMG->DMG_MMU, Start);
+    }
+
+    //+1 for the tick CPUTick spends starting the instruction before it counts down MMU->Ticks.
+    int Ticks = CPUStep(&DMG->DMG_CPU, &DMG->DMG_MMU) + 1;
+
+    //The PPU rewrites the STAT interrupt flag every tick, so it has to notice the CPU changing it (Write or interrupt dispatch).
+    if ((OldIF ^ DMG->DMG_MMU.SystemMemory[0xFF0F]) & 0x02) {
+        DMGWakeComponent(DMG, SCHED_PPU);
+    }
+
+    //Halted with nothing pending, only an event can change that. Skip every HALT check up to and including the one on the event's tick.
+    uint8_t Pending = DMG->DMG_MMU.SystemMemory[0xFF0F] & DMG->DMG_MMU.SystemMemory[0xFFFF];
+    if (DMG->DMG_CPU.HALT == 1 && Pending == 0 && DMG->DMG_MMU.DMACount == 0 && DMG->DMG_CPU.LOG == 0 && DMG->DMG_MMU.DEBUGMODE == 0) {
+        uint64_t Next = SchedulerNext(Scheduler);
+        if (Next >= Start + Ticks) {
+            Ticks += Ticks * (int)((Next - Start) / Ticks);
+        }
+    }
+
+    //OAM DMA and the PPU's OAM search share memory, so keep the PPU in lockstep with the transfer.
+    if (DMG->DMG_MMU.DMACount > 0) {
+        DMGSyncComponent(DMG, SCHED_PPU, Start);
+        for (int i = 0; i < Ticks; i++) {
+            DMGSyncComponent(DMG, SCHED_PPU, Start + i + 1);
+            DMATick(&DMG->DMG_MMU);
+        }
+        DMGScheduleComponent(DMG, SCHED_PPU);
+    }
+
+    Scheduler->Cycle = Start + Ticks;
+
+    //Handle every event that is due before the next instruction starts.
+    while (SchedulerNext(Scheduler) < Scheduler->Cycle) {
+        int Type = SchedulerPop(Scheduler);
+        DMGSyncComponent(DMG, Type, Scheduler->Cycle);
+        DMGScheduleComponent(DMG, Type);
+    }
+    return Ticks;
+}
+
+void DMGCatchUp(DMG *DMG) {
+    for (int i = 0; i < SCHED_DEADLINE; i++) {
+        DMGSyncComponent(DMG, i, DMG->DMG_Scheduler.Cycle);
+    }
+    PPUFlush(&DMG->DMG_PPU, &DMG->DMG_MMU);
+}
 
 void DMGInit(DMG *DMG) {
-    //Set up SDL Window
-    DMGGraphicsInit();
+    memset(DMG, 0, sizeof(*DMG)); //Nothing left uninitialised, so the same machine always saves the same state
+    //Set up SDL Window (Skipped for headless runs)
+    if (!Headless) {
+        DMGGraphicsInit();
+    }
     //Set up CPU
     CPUInit(&DMG->DMG_CPU);
     //Set up system memory
@@ -48,23 +174,117 @@ void DMGInit(DMG *DMG) {
     TimerInit(&DMG->DMG_Timer, &DMG->DMG_MMU);
     PPUInit(&DMG->DMG_PPU, &DMG->DMG_MMU);
     APUInit(&DMG->DMG_APU, &DMG->DMG_MMU); 
+    DMG->DMG_APU.Muted = 0;
+    APUInitOutput(&DMG->DMG_APU, 44100); //Until the host asks for its own rate
+
+    //Set up the Scheduler, every component starts out due on the first tick.
+    SchedulerInit(&DMG->DMG_Scheduler);
+    for (int i = 0; i < SCHED_DEADLINE; i++) {
+        DMGScheduleComponent(DMG, i);
+    }
+    DMG->DMG_MMU.WriteHook = DMGWriteHook;
+    DMG->DMG_MMU.SoundWrite = DMGSoundWrite;
+    DMG->DMG_MMU.HookContext = DMG;
+}
+
+//MMU clock hook, the virtual clock only moves with the ticks that were run.
+static int64_t DMGClockRead(void *Context) {
+    DMG *Gameboy = (DMG *)Context;
+    return Gameboy->ClockStart + (int64_t)(Gameboy->DMG_Scheduler.Cycle - Gameboy->ClockCycle) / 4194304; //Signed, rewinding can go back past ClockCycle
+}
+
+int64_t DMGGetClock(DMG *DMG) {
+    if (DMG->DMG_MMU.ClockRead != NULL) {
+        return DMGClockRead(DMG);
+    }
+    //Local time as if it were UTC (What the RTC shows now), so switching to a virtual clock doesn't move the game's clock by the time zone.
+    time_t Now = time(NULL);
+    struct tm UTC = *gmtime(&Now);
+    UTC.tm_isdst = -1;
+    return (int64_t)Now + (int64_t)(Now - mktime(&UTC));
+}
+
+void DMGSetClock(DMG *DMG, int64_t Seconds) {
+    DMG->ClockStart = Seconds;
+    DMG->ClockCycle = DMG->DMG_Scheduler.Cycle;
+    DMG->DMG_MMU.ClockRead = DMGClockRead;
 }
 
 void DMGGraphicsInit() {
+#ifndef HEADLESS
     // SDL initialization and window + renderer creation
     SDL_Init(SDL_INIT_EVERYTHING);
     window = SDL_CreateWindow("Emoo-Boy", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, (160 * SCALE), (144 * SCALE), SDL_WINDOW_ALLOW_HIGHDPI);
     renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB888, SDL_TEXTUREACCESS_STREAMING, 160, 144);
-    // Audio initialization
-    audio.freq = 44100;
-    audio.format = AUDIO_S16SYS;
-    audio.channels = 2;
-    audio.samples = 1024; // Buffer size for smooth playback
-    audio.callback = NULL;
-    audio.userdata = NULL;
-
-    audioDevice = SDL_OpenAudioDevice(NULL, 0, &audio, &audio2, 0);
-
-    SDL_PauseAudioDevice(audioDevice, 0);
-}
\ No newline at end of file
+    //The audio device is opened by AudioInit, which feeds it from the emulation thread.
+#endif
+}
+
+void DMGRunFrame(DMG *DMG) {
+    Scheduler *Scheduler = &DMG->DMG_Scheduler;
+    uint64_t End = Scheduler->Cycle + DMG_FRAME_TICKS;
+
+    DMG->DMG_PPU.FrameReady = 0;
+    //Bounded by a frame of ticks so a game that leaves the LCD off still returns (The deadline keeps HALT from skipping past it).
+    SchedulerSet(Scheduler, SCHED_DEADLINE, End - 1);
+    while (Scheduler->Cycle < End && !DMG->DMG_PPU.FrameReady) {
+        DMGStep(DMG);
+    }
+    SchedulerRemove(Scheduler, SCHED_DEADLINE);
+
+    //Leave every register and the audio output up to date for the caller.
+    DMGCatchUp(DMG);
+}
+
+void DMGGetFrame(DMG *DMG, uint32_t *Pixels) {
+    if (Pixels != DMG->DMG_PPU.Framebuffer) {
+        memcpy(Pixels, DMG->DMG_PPU.Framebuffer, sizeof(DMG->DMG_PPU.GameBoyDisplay));
+    }
+}
+
+uint64_t DMGFrameHash(DMG *DMG) {
+    return HashBytes(DMG->DMG_PPU.Framebuffer, sizeof(DMG->DMG_PPU.GameBoyDisplay), 0);
+}
+
+uint64_t DMGAudioHash(const int16_t *Samples, int Frames, uint64_t Seed) {
+    return HashBytes(Samples, (size_t)Frames * 2 * sizeof(int16_t), Seed);
+}
+
+void DMGSetFramebuffer(DMG *DMG, uint32_t *Pixels) {
+    PPU *PPU = &DMG->DMG_PPU;
+    uint32_t *Target = (Pixels != NULL) ? Pixels : &PPU->GameBoyDisplay[0][0];
+
+    //Pixels nothing gets drawn on keep their colour from the last frame, so carry it over.
+    if (Target != PPU->Framebuffer) {
+        memcpy(Target, PPU->Framebuffer, sizeof(PPU->GameBoyDisplay));
+        PPU->Framebuffer = Target;
+    }
+}
+
+int DMGGetAudio(DMG *DMG, int16_t *Samples, int MaxFrames) {
+    APUEndFrame(&DMG->DMG_APU);
+    return BlipRead(&DMG->DMG_APU.Output, Samples, MaxFrames);
+}
+
+//Used for fast forwarding. The PPU picks the video setting up when the next frame starts, the APU from the next sample.
+void DMGSetOutput(DMG *DMG, int Video, int Audio) {
+    DMG->DMG_PPU.SkipDrawing = !Video;
+    DMG->DMG_APU.Muted = !Audio;
+}
+
+void DMGSetAudioRate(DMG *DMG, double Rate) {
+    APUEndFrame(&DMG->DMG_APU); //The new rate starts at the APU's current tick
+    BlipSetRate(&DMG->DMG_APU.Output, Rate);
+}
+
+int DMGFrameDrawn(DMG *DMG) {
+    return DMG->DMG_PPU.FrameReady && !DMG->DMG_PPU.SkipFrame;
+}
+
+void DMGSetButtons(DMG *DMG, uint8_t Buttons) {
+    for (int i = 0; i < 8; i++) {
+        DMG->DMG_MMU.GameBoyController[i] = (Buttons & (1 << i)) ? 0 : 1;
+    }
+    MMUUpdateJoypad(&DMG->DMG_MMU);
+}
@@ -6,6 +6,7 @@
 #include "MMU.h"
 #include "Timer.h"
 #include "APU.h"
+#include "Scheduler.h"
 //#include "APU
 
 typedef struct {
@@ -14,11 +15,33 @@ typedef struct {
     MMU DMG_MMU;
     Timer DMG_Timer;
     APU DMG_APU;
+    Scheduler DMG_Scheduler;
+
+    //Virtual RTC clock (DMGSetClock), ClockStart seconds at tick ClockCycle and one more second every 4194304 ticks after it.
+    int64_t ClockStart;
+    uint64_t ClockCycle;
 } DMG;
 
 
 void DMGInit(DMG *DMG);
 void DMGGraphicsInit();
-void DMGTick(DMG *DMG);
+int DMGStep(DMG *DMG); //Runs one instruction then any component events that came due, returns the ticks that took.
+void DMGCatchUp(DMG *DMG); //Runs every component up to the current tick (Only needed before looking at their state from outside).
+
+//Headless API, frames and audio are handed back to the caller instead of SDL.
+void DMGRunFrame(DMG *DMG); //Runs until the next VBlank (or one frame worth of ticks while the LCD is off).
+void DMGGetFrame(DMG *DMG, uint32_t *Pixels); //Writes the last frame as 160x144 0xRRGGBB values, row by row.
+void DMGSetFramebuffer(DMG *DMG, uint32_t *Pixels); //Draws straight into the caller's 160x144 buffer from now on (NULL goes back to the PPU's own).
+int DMGGetAudio(DMG *DMG, int16_t *Samples, int MaxFrames); //Drains up to MaxFrames interleaved stereo frames, returns how many were written.
+void DMGSetAudioRate(DMG *DMG, double Rate); //Stereo frames per second of emulated time DMGGetAudio hands back (44100 by default), takes effect from the APU's current tick.
+void DMGSetButtons(DMG *DMG, uint8_t Buttons); //One bit per button in GameBoyController order, 1 = pressed.
+void DMGSetOutput(DMG *DMG, int Video, int Audio); //Turns pixel drawing (from the next frame) and audio mixing off (0) or on (1), timing and interrupts stay exact either way.
+int DMGFrameDrawn(DMG *DMG); //1 if the last DMGRunFrame stopped at the VBlank of a frame that was drawn, 0 if it was skipped or the LCD is off.
+void DMGSetClock(DMG *DMG, int64_t Seconds); //The RTC reads Seconds (since 1970, UTC) now and runs on in emulated time instead of following the host's clock.
+int64_t DMGGetClock(DMG *DMG); //What the RTC reads right now in the same terms, the host's local time counted as UTC unless a virtual clock is set.
+
+//Output hashes (XXH64) for comparing runs, a single changed pixel or sample changes them. Pixels and samples are hashed in the host's byte order.
+uint64_t DMGFrameHash(DMG *DMG); //Hash of the last frame (DMGGetFrame's pixels), call after DMGRunFrame.
+uint64_t DMGAudioHash(const int16_t *Samples, int Frames, uint64_t Seed); //Hash of a chunk from DMGGetAudio, Seed chains it onto the hash of the chunk before.
 
-#endif
\ No newline at end of file
+#endif
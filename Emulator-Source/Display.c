@@ -0,0 +1,302 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Display.h"
+#include "State.h"
+
+#ifndef HEADLESS
+extern SDL_Window *window;
+extern SDL_Renderer *renderer;
+extern SDL_Texture* texture;
+extern int SCALE;
+extern int TargetFPS;
+extern int EmulationSpeed;
+extern int FastForwardFrames;
+extern int RewindMemory;
+extern int RewindInterval;
+extern char ROMFilePath[512];
+extern int MovieMode;
+extern char MoviePath[512];
+
+//Up, Down, Left, Right, A, B, Start, Select (GameBoyController order)
+static const SDL_Keycode DisplayKeyMap[8] = {
+    SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT,
+    SDLK_z, SDLK_x, SDLK_a, SDLK_s
+};
+
+void DisplayInit(Display *Display, DMG *Gameboy) {
+    Display->Gameboy = Gameboy;
+    Display->Back = 0;
+    Display->Front = 2;
+    SDL_AtomicSet(&Display->Shared, 1);
+    SDL_AtomicSet(&Display->Buttons, 0);
+    SDL_AtomicSet(&Display->Quit, 0);
+    SDL_AtomicSet(&Display->StateRequest, 0);
+    SDL_AtomicSet(&Display->Rewinding, 0);
+    PacingInit(&Display->Pacer, EmulationSpeed);
+    if (AudioInit(&Display->Sound) == 0) {
+        DMGSetAudioRate(Gameboy, Display->Sound.Frequency);
+    }
+
+    //Every buffer starts out as the blank frame from PPUInit
+    DMGSetFramebuffer(Gameboy, Display->Buffers[Display->Back]);
+    memcpy(Display->Buffers[1], Display->Buffers[0], sizeof(Display->Buffers[0]));
+    memcpy(Display->Buffers[2], Display->Buffers[0], sizeof(Display->Buffers[0]));
+
+    //The movie starts from power on, before the first rewind snapshot.
+    MovieInit(&Display->Film);
+    if (MovieMode == MOVIE_RECORDING) {
+        MovieRecord(&Display->Film, Gameboy, MOVIE_START_POWER_ON, DMGGetClock(Gameboy));
+        printf("Recording a movie to %s\n", MoviePath);
+    }
+    else if (MovieMode == MOVIE_PLAYING && MovieLoad(&Display->Film, MoviePath) == 0) {
+        if (MoviePlay(&Display->Film, Gameboy) == 0) {
+            printf("Playing %s (%u frames)\n", MoviePath, Display->Film.Header.Frames);
+        }
+        else {
+            printf("Error: %s starts from a save state made by another build\n", MoviePath);
+        }
+    }
+
+    RewindInit(&Display->History, Gameboy, (size_t)RewindMemory << 20, RewindInterval);
+}
+
+void DisplayPublish(Display *Display) {
+    //The finished frame becomes the shared buffer, whichever buffer was shared before (shown or not) is free to draw into.
+    Display->Back = SDL_AtomicSet(&Display->Shared, Display->Back | DISPLAY_FRESH) & 0x03;
+    DMGSetFramebuffer(Display->Gameboy, Display->Buffers[Display->Back]);
+}
+
+//Emulation thread, saves or loads the state in "<ROM Path>.state" next to the ROM. Done right after a frame, so the frame in the state is the one being shown.
+static void DisplayHandleState(Display *Display, int Request) {
+    char Path[520];
+    snprintf(Path, sizeof(Path), "%s.state", ROMFilePath);
+
+    if (Request == DISPLAY_STATE_SAVE) {
+        if (StateSaveFile(Display->Gameboy, Path) == 0) {
+            printf("State saved to %s\n", Path);
+        }
+        else {
+            printf("Error: Could not save the state to %s\n", Path);
+        }
+    }
+    else if (StateLoadFile(Display->Gameboy, Path) == 0) {
+        printf("State loaded from %s\n", Path);
+        //The movie can't follow the jump, a recording starts over from the loaded state and playback stops.
+        if (Display->Film.Mode == MOVIE_RECORDING) {
+            MovieRecord(&Display->Film, Display->Gameboy, MOVIE_START_STATE, DMGGetClock(Display->Gameboy));
+            printf("The movie starts over from the loaded state\n");
+        }
+        else if (Display->Film.Mode == MOVIE_PLAYING) {
+            Display->Film.Mode = MOVIE_OFF;
+            printf("Movie playback stopped\n");
+        }
+    }
+    else {
+        printf("Error: No state of this game in %s\n", Path);
+    }
+}
+
+//Emulation thread, after a rewind step took Frames frames back. Going back past the start of the movie works like loading a state.
+static void DisplayMovieBack(Display *Display, int Frames) {
+    if (Display->Film.Mode == MOVIE_OFF || MovieBack(&Display->Film, Frames) == 0) {
+        return;
+    }
+    if (Display->Film.Mode == MOVIE_RECORDING) {
+        MovieRecord(&Display->Film, Display->Gameboy, MOVIE_START_STATE, DMGGetClock(Display->Gameboy));
+        printf("Rewound past the start of the movie, it starts over from here\n");
+    }
+    else {
+        Display->Film.Mode = MOVIE_OFF;
+        printf("Rewound past the start of the movie, playback stopped\n");
+    }
+}
+
+//Emulation thread, runs a frame at a time and lets the pacer hold it to real time.
+static int DisplayEmulationThread(void *Data) {
+    Display *Screen = (Display *)Data;
+    Scheduler *Scheduler = &Screen->Gameboy->DMG_Scheduler;
+    int Skipped = 0;
+    int16_t Samples[1024 * 2];
+
+    while (!SDL_AtomicGet(&Screen->Quit)) {
+        //Holding Backspace steps back through the snapshots instead of running, one per frame of real time. Stepping back puts the snapshot's frame in the back buffer.
+        if (SDL_AtomicGet(&Screen->Rewinding)) {
+            int Frames = RewindStep(&Screen->History);
+            if (Frames > 0) {
+                DisplayPublish(Screen);
+                DisplayMovieBack(Screen, Frames);
+            }
+            PacingWait(&Screen->Pacer, DISPLAY_FRAME_TICKS);
+            continue;
+        }
+
+        //Fast forwarding (Turbo) only draws every FastForwardFrames-th frame and mixes no audio at all, the rest only run the game logic.
+        int FastForward = SDL_AtomicGet(&Screen->Pacer.Turbo);
+        int Draw = !FastForward || Skipped + 1 >= FastForwardFrames;
+        DMGSetOutput(Screen->Gameboy, Draw, !FastForward);
+
+        uint64_t Start = Scheduler->Cycle;
+        //A movie being played replaces the keyboard until it runs out.
+        uint8_t Buttons = (uint8_t)SDL_AtomicGet(&Screen->Buttons);
+        if (Screen->Film.Mode == MOVIE_PLAYING && !MovieNextFrame(&Screen->Film, &Buttons)) {
+            printf("Movie finished, the keyboard has control again\n");
+        }
+        DMGSetButtons(Screen->Gameboy, Buttons);
+        DMGRunFrame(Screen->Gameboy);
+        if (Screen->Film.Mode == MOVIE_RECORDING) {
+            MovieAddFrame(&Screen->Film, Buttons);
+        }
+
+        //Both go before the frame is handed over, while the finished frame is still the one being drawn into.
+        RewindFrame(&Screen->History);
+        int Request = SDL_AtomicSet(&Screen->StateRequest, 0);
+        if (Request != 0) {
+            DisplayHandleState(Screen, Request);
+        }
+
+        //Only finished, drawn frames get handed over. A skipped frame (or a run with the LCD off) left the back buffer as it was, so it stays where it is.
+        if (DMGFrameDrawn(Screen->Gameboy)) {
+            DisplayPublish(Screen);
+            Skipped = 0;
+        }
+        else {
+            Skipped++;
+        }
+
+        //Hand the frame's audio over and steer the rate for the next frame. The fill is measured before the push, at its lowest point, since that's the one that must not reach zero.
+        double Rate = AudioRate(&Screen->Sound);
+        int Frames;
+        while ((Frames = DMGGetAudio(Screen->Gameboy, Samples, 1024)) > 0) {
+            AudioPush(&Screen->Sound, Samples, Frames);
+        }
+        DMGSetAudioRate(Screen->Gameboy, Rate);
+
+        //Paced on the ticks actually run, frames cut short by the LCD turning on or off are shorter in real time too.
+        PacingWait(&Screen->Pacer, Scheduler->Cycle - Start);
+    }
+    return 0;
+}
+
+//Q and W step the speed down and up, E puts it back to the real hardware speed.
+static void DisplayChangeSpeed(Display *Display, int Speed) {
+    if (Speed < DISPLAY_SPEED_STEP) {
+        Speed = DISPLAY_SPEED_STEP;
+    }
+    EmulationSpeed = Speed;
+    PacingSetSpeed(&Display->Pacer, Speed);
+    printf("Emulation Speed: %d%%\n", Speed);
+}
+
+//Handles the window and keyboard events, returns 1 once the user wants to quit.
+static int DisplayPollEvents(Display *Display) {
+    SDL_Event event;
+    int Buttons = SDL_AtomicGet(&Display->Buttons);
+    int Quit = 0;
+
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_QUIT) {
+            Quit = 1;
+        }
+        if (event.type == SDL_KEYDOWN) {
+            for (int i = 0; i < 8; i++) {
+                if (event.key.keysym.sym == DisplayKeyMap[i]) {
+                    Buttons |= (1 << i);
+                }
+            }
+            if (event.key.keysym.sym == SDLK_ESCAPE) {
+                Quit = 1;
+            }
+            if (event.key.keysym.sym == SDLK_q) {
+                DisplayChangeSpeed(Display, EmulationSpeed - DISPLAY_SPEED_STEP);
+            }
+            if (event.key.keysym.sym == SDLK_w) {
+                DisplayChangeSpeed(Display, EmulationSpeed + DISPLAY_SPEED_STEP);
+            }
+            if (event.key.keysym.sym == SDLK_e) {
+                DisplayChangeSpeed(Display, 100);
+            }
+            if (event.key.keysym.sym == SDLK_TAB) {
+                PacingSetTurbo(&Display->Pacer, 1); //Held down for turbo
+            }
+            if (event.key.keysym.sym == SDLK_F5) {
+                SDL_AtomicSet(&Display->StateRequest, DISPLAY_STATE_SAVE);
+            }
+            if (event.key.keysym.sym == SDLK_F8) {
+                SDL_AtomicSet(&Display->StateRequest, DISPLAY_STATE_LOAD);
+            }
+            if (event.key.keysym.sym == SDLK_BACKSPACE) {
+                SDL_AtomicSet(&Display->Rewinding, 1); //Held down to rewind
+            }
+        }
+        if (event.type == SDL_KEYUP) {
+            for (int i = 0; i < 8; i++) {
+                if (event.key.keysym.sym == DisplayKeyMap[i]) {
+                    Buttons &= ~(1 << i);
+                }
+            }
+            if (event.key.keysym.sym == SDLK_TAB) {
+                PacingSetTurbo(&Display->Pacer, 0);
+            }
+            if (event.key.keysym.sym == SDLK_BACKSPACE) {
+                SDL_AtomicSet(&Display->Rewinding, 0);
+            }
+        }
+    }
+    SDL_AtomicSet(&Display->Buttons, Buttons);
+    return Quit;
+}
+
+int DisplayRun(Display *Display) {
+    SDL_Thread *Thread = SDL_CreateThread(DisplayEmulationThread, "Emulation", Display);
+    if (Thread == NULL) {
+        printf("Error: Could not start the emulation thread (%s)\n", SDL_GetError());
+        return -1;
+    }
+
+    uint64_t Frequency = SDL_GetPerformanceFrequency();
+    uint64_t Interval = Frequency / ((TargetFPS > 0) ? TargetFPS : 60);
+    uint64_t Next = SDL_GetPerformanceCounter();
+
+    while (!SDL_AtomicGet(&Display->Quit)) {
+        if (DisplayPollEvents(Display)) {
+            SDL_AtomicSet(&Display->Quit, 1);
+        }
+
+        //Take the newest frame if the core finished one since last time, otherwise show the same one again.
+        if (SDL_AtomicGet(&Display->Shared) & DISPLAY_FRESH) {
+            Display->Front = SDL_AtomicSet(&Display->Shared, Display->Front) & 0x03;
+            SDL_UpdateTexture(texture, NULL, Display->Buffers[Display->Front], 160 * sizeof(uint32_t));
+        }
+
+        SDL_RenderClear(renderer);
+        SDL_Rect UpscaledImage = {0, 0, (160 * SCALE), (144 * SCALE)};
+        SDL_RenderCopy(renderer, texture, NULL, &UpscaledImage);
+        SDL_RenderPresent(renderer);
+
+        //Present at TargetFPS (Vsync still caps it at the monitor's refresh rate)
+        Next += Interval;
+        uint64_t Now = SDL_GetPerformanceCounter();
+        if (Now < Next) {
+            SDL_Delay((Uint32)((Next - Now) * 1000 / Frequency));
+        }
+        else if (Now - Next > Interval * 5) {
+            Next = Now;
+        }
+    }
+
+    SDL_WaitThread(Thread, NULL);
+    AudioClose(&Display->Sound);
+    RewindFree(&Display->History);
+    if (Display->Film.Mode == MOVIE_RECORDING) {
+        if (MovieSave(&Display->Film, MoviePath) == 0) {
+            printf("Movie saved to %s (%u frames)\n", MoviePath, Display->Film.Header.Frames);
+        }
+        else {
+            printf("Error: Could not save the movie to %s\n", MoviePath);
+        }
+    }
+    MovieFree(&Display->Film);
+    return 0;
+}
+#endif
@@ -0,0 +1,46 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#ifndef HEADLESS
+#include "DMG.h"
+#include "Pacing.h"
+#include "Audio.h"
+#include "Rewind.h"
+#include "Movie.h"
+
+/*
+    Display (Triple buffered frame handoff)
+    The core runs on its own thread and draws every frame straight into one of three buffers. At VBlank it swaps that buffer with the shared
+    one, and the presentation thread (the one that made the window) swaps the shared buffer with the one it shows whenever a new frame is there.
+    Neither side ever waits on the other, so vsync no longer holds up emulation and the display can refresh at its own rate (TargetFPS).
+*/
+#define DISPLAY_FRESH 0x04 //Set in Shared while the buffer there is a frame the presentation thread hasn't taken yet
+#define DISPLAY_SPEED_STEP 25 //Percent Q and W change the speed by
+#define DISPLAY_FRAME_TICKS 70224 //One Game Boy frame, how long each rewind step is held on screen
+#define DISPLAY_STATE_SAVE 1 //StateRequest values, F5 saves the state and F8 loads it back
+#define DISPLAY_STATE_LOAD 2
+
+typedef struct {
+    uint32_t Buffers[3][160 * 144];
+    SDL_atomic_t Shared; //Buffer index waiting between the two threads, plus DISPLAY_FRESH
+    int Back; //Being drawn by the emulation thread
+    int Front; //Being shown by the presentation thread
+
+    SDL_atomic_t Buttons; //Controller state from the key events, one bit per button in GameBoyController order (1 = pressed)
+    SDL_atomic_t Quit;
+    SDL_atomic_t StateRequest; //Save or load asked for by the key events, done by the emulation thread between frames
+    SDL_atomic_t Rewinding; //Set while Backspace is held
+
+    Pacing Pacer; //Keeps the emulation thread at the Game Boy's speed (or the multiple of it the user picked)
+    Audio Sound; //Filled by the emulation thread after every frame
+    Rewind History; //Snapshot taken by the emulation thread after every frame (or every RewindInterval frames)
+    Movie Film; //Recorded or played by the emulation thread when the emulator was started with --record or --play
+    DMG *Gameboy;
+} Display;
+
+void DisplayInit(Display *Display, DMG *Gameboy); //Sets up the buffers and points the DMG's framebuffer at the back buffer.
+void DisplayPublish(Display *Display); //Emulation thread, hands over the finished frame and carries on drawing into a free buffer.
+int DisplayRun(Display *Display); //Starts the emulation thread, then presents frames and handles input on this thread until the user quits.
+
+#endif
+#endif // DISPLAY_H
@@ -0,0 +1,89 @@
+#include <string.h>
+#include "Hash.h"
+
+#define HASH_PRIME1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME3 0x165667B19E3779F9ULL
+#define HASH_PRIME4 0x85EBCA77C2B2AE63ULL
+#define HASH_PRIME5 0x27D4EB2F165667C5ULL
+
+#define HashRotate(Value, Bits) (((Value) << (Bits)) | ((Value) >> (64 - (Bits))))
+
+//Unaligned little endian reads (memcpy turns into a single load).
+static uint64_t HashRead64(const uint8_t *Bytes) {
+    uint64_t Value;
+    memcpy(&Value, Bytes, 8);
+    return Value;
+}
+static uint32_t HashRead32(const uint8_t *Bytes) {
+    uint32_t Value;
+    memcpy(&Value, Bytes, 4);
+    return Value;
+}
+
+static uint64_t HashRound(uint64_t Accumulator, uint64_t Input) {
+    Accumulator += Input * HASH_PRIME2;
+    Accumulator = HashRotate(Accumulator, 31);
+    return Accumulator * HASH_PRIME1;
+}
+
+static uint64_t HashMerge(uint64_t Hash, uint64_t Accumulator) {
+    Hash ^= HashRound(0, Accumulator);
+    return Hash * HASH_PRIME1 + HASH_PRIME4;
+}
+
+uint64_t HashBytes(const void *Data, size_t Size, uint64_t Seed) {
+    const uint8_t *Bytes = (const uint8_t *)Data;
+    const uint8_t *End = Bytes + Size;
+    uint64_t Hash;
+
+    //Four independent lanes over 32 byte stripes, then folded together.
+    if (Size >= 32) {
+        uint64_t Lane1 = Seed + HASH_PRIME1 + HASH_PRIME2;
+        uint64_t Lane2 = Seed + HASH_PRIME2;
+        uint64_t Lane3 = Seed;
+        uint64_t Lane4 = Seed - HASH_PRIME1;
+        do {
+            Lane1 = HashRound(Lane1, HashRead64(Bytes));
+            Lane2 = HashRound(Lane2, HashRead64(Bytes + 8));
+            Lane3 = HashRound(Lane3, HashRead64(Bytes + 16));
+            Lane4 = HashRound(Lane4, HashRead64(Bytes + 24));
+            Bytes += 32;
+        } while (Bytes + 32 <= End);
+
+        Hash = HashRotate(Lane1, 1) + HashRotate(Lane2, 7) + HashRotate(Lane3, 12) + HashRotate(Lane4, 18);
+        Hash = HashMerge(Hash, Lane1);
+        Hash = HashMerge(Hash, Lane2);
+        Hash = HashMerge(Hash, Lane3);
+        Hash = HashMerge(Hash, Lane4);
+    }
+    else {
+        Hash = Seed + HASH_PRIME5;
+    }
+    Hash += (uint64_t)Size;
+
+    //Whatever didn't fill a stripe
+    while (Bytes + 8 <= End) {
+        Hash ^= HashRound(0, HashRead64(Bytes));
+        Hash = HashRotate(Hash, 27) * HASH_PRIME1 + HASH_PRIME4;
+        Bytes += 8;
+    }
+    if (Bytes + 4 <= End) {
+        Hash ^= (uint64_t)HashRead32(Bytes) * HASH_PRIME1;
+        Hash = HashRotate(Hash, 23) * HASH_PRIME2 + HASH_PRIME3;
+        Bytes += 4;
+    }
+    while (Bytes < End) {
+        Hash ^= (*Bytes) * HASH_PRIME5;
+        Hash = HashRotate(Hash, 11) * HASH_PRIME1;
+        Bytes++;
+    }
+
+    //Avalanche, so every input bit reaches every output bit
+    Hash ^= Hash >> 33;
+    Hash *= HASH_PRIME2;
+    Hash ^= Hash >> 29;
+    Hash *= HASH_PRIME3;
+    Hash ^= Hash >> 32;
+    return Hash;
+}
@@ -0,0 +1,14 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+    Hash (XXH64)
+    A fast 64 bit non-cryptographic hash, the same function and results as xxHash's XXH64. Used to tell ROMs apart and to compare emulator
+    output between runs, where a changed bit anywhere has to change the hash but nobody is trying to forge one.
+*/
+uint64_t HashBytes(const void *Data, size_t Size, uint64_t Seed);
+
+#endif // HASH_H
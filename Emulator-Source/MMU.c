@@ -1,8 +1,16 @@
 #include <cstdio>
 #include <stdlib.h>
-#include <SDL2/SDL.h>
+#include <string.h>
 #include "MMU.h"
 #include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 extern int ROMSize; 
 extern int RAMSize; 
@@ -11,12 +19,14 @@ extern char ROMFilePath[512];
 extern char RAMFilePath[512]; 
 extern int MBCType;
 extern int Exit;
-extern int RenderingSpeed;
+extern int Headless;
+extern uint8_t *ROMImage;
+extern size_t ROMImageSize;
 
 //Memory Management Functions
 void MMUInit(MMU *MMU) {
-    MMU->ROMFile = (Uint8 *)malloc(ROMSize * sizeof(uint8_t));
-    MMU->RAMFile = (Uint8 *)malloc(RAMSize * sizeof(uint8_t));
+    MMU->ROMFile = NULL; //Set by MMULoadFile
+    MMU->RAMFile = (uint8_t *)malloc(RAMSize * sizeof(uint8_t));
 
     
     //Initialize the System Memory (Set Everything to xFF)
@@ -45,24 +55,89 @@ void MMUInit(MMU *MMU) {
     for (int i = 0; i < 8; i++) {
         MMU->GameBoyController[i] = 1;
     }
+    MMU->JoypadButtons = 0x0F;
+    MMU->JoypadDirections = 0x0F;
+
+    MMU->WriteHook = NULL;
+    MMU->HookContext = NULL;
+    MMU->SoundWrite = NULL;
+    MMU->ClockRead = NULL;
+    MMU->VRAMTrap = 0;
+    memset(MMU->TileDirty, 1, sizeof(MMU->TileDirty)); //Nothing has been decoded yet
+
+    MMUMapPages(MMU);
 }
 void MMUFree(MMU *MMU) {
-    free(MMU->ROMFile);
+    //The mapped ROM is shared with every other instance, only a padded copy belongs to this MMU
+    if (MMU->ROMFile != ROMImage) {
+        free(MMU->ROMFile);
+    }
     free(MMU->RAMFile);
 }
 
 //File Functions
-void MMULoadFile(MMU *MMU) {
-    //Read and Load Data from the Given ROM File
-    FILE *romfile = fopen(ROMFilePath, "rb");
-    fseek(romfile, 0, SEEK_END);
-    size_t fileSize = ftell(romfile);
-    fseek(romfile, 0, SEEK_SET);
-    size_t bytesRead = fread(MMU->ROMFile, 1, fileSize, romfile);
-    fclose(romfile);
+//Maps a ROM file read-only. Nothing gets read until a bank is first touched, and the pages come straight out of the OS file cache,
+//so every emulator (or process) running the same ROM shares them. Nothing may write to it, anything that patches ROM bytes works on its own copy.
+uint8_t *MMUMapROM(const char *Path, size_t *Size) {
+#ifdef _WIN32
+    HANDLE File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (File == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    LARGE_INTEGER FileSize;
+    if (!GetFileSizeEx(File, &FileSize) || FileSize.QuadPart == 0) {
+        CloseHandle(File);
+        return NULL;
+    }
+    HANDLE Mapping = CreateFileMappingA(File, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(File);
+    if (Mapping == NULL) {
+        return NULL;
+    }
+    void *View = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(Mapping); //The view keeps the mapping alive
+    if (View == NULL) {
+        return NULL;
+    }
+    *Size = (size_t)FileSize.QuadPart;
+    return (uint8_t *)View;
+#else
+    int File = open(Path, O_RDONLY);
+    if (File < 0) {
+        return NULL;
+    }
+    struct stat Info;
+    if (fstat(File, &Info) != 0 || Info.st_size == 0) {
+        close(File);
+        return NULL;
+    }
+    void *View = mmap(NULL, Info.st_size, PROT_READ, MAP_PRIVATE, File, 0);
+    close(File); //The mapping keeps the file open
+    if (View == MAP_FAILED) {
+        return NULL;
+    }
+    *Size = (size_t)Info.st_size;
+    return (uint8_t *)View;
+#endif
+}
+void MMUUnmapROM(uint8_t *ROM, size_t Size) {
+#ifdef _WIN32
+    UnmapViewOfFile(ROM);
+#else
+    munmap(ROM, Size);
+#endif
+}
 
-    //Load the first two banks of ROM into the system memory
-    memcpy(MMU->SystemMemory, MMU->ROMFile, 0x8000); //Load ROM Bank 0-1 into the system memory location 0x0000-0x7FFF
+void MMULoadFile(MMU *MMU) {
+    //Use the ROM mapped by ReadROMHeader. If the header claims more banks than the file has, fall back to a padded copy so every bank stays readable.
+    if (ROMImageSize >= (size_t)ROMSize) {
+        MMU->ROMFile = ROMImage;
+    }
+    else {
+        MMU->ROMFile = (uint8_t *)malloc(ROMSize * sizeof(uint8_t));
+        memset(MMU->ROMFile, 0xFF, ROMSize);
+        memcpy(MMU->ROMFile, ROMImage, ROMImageSize);
+    }
 
     //check if the user wanted to load a ram file, and if so, load the data.
     if ((RAMSize > 0) && (LoadSaveFile == 1)) {
@@ -74,19 +149,17 @@ void MMULoadFile(MMU *MMU) {
             memset(MMU->RAMFile, 0xFF, RAMSize);
             printf("Save file %s not found. A new save file will be created on exit.\n", RAMFilePath);
         }
-        //Load the first bank of RAM into the system memory
-        memcpy(MMU->SystemMemory + 0xA000, MMU->RAMFile, 0x2000); //Load External RAM Bank 0 into the system memory location 0xA000-0xBFFF
     }
     else {
-        memset(MMU->SystemMemory + 0xA000, 0xFF, 0x2000); //fill External RAM Bank 0 with 0xFF
+        memset(MMU->RAMFile, 0xFF, RAMSize); //fill External RAM with 0xFF
+        memset(MMU->SystemMemory + 0xA000, 0xFF, 0x2000); //Carts without RAM still get 0xFF here
     }
+    //ROM and RAM banks are mapped straight out of ROMFile/RAMFile.
+    MMUMapPages(MMU);
 }
 void MMUSaveFile(MMU *MMU) {
     if (RAMSize > 0 && LoadSaveFile) {
-        //Write Current RAM Bank to RAM File
-        size_t CurrentBaseAddress = 0x2000 * MMU->CurrentRAMBank;
-        memcpy(MMU->RAMFile + CurrentBaseAddress, MMU->SystemMemory + 0xA000, 0x2000);
-        //Save the RAM data to the given file
+        //Save the RAM data to the given file (Writes to 0xA000-0xBFFF land in RAMFile directly, nothing to copy back)
         if (RAMSize > 0 && LoadSaveFile) {
             FILE *ramfile = fopen(RAMFilePath, "wb");
             fwrite(MMU->RAMFile, 1, RAMSize, ramfile);
@@ -100,40 +173,100 @@ void MMUSaveFile(MMU *MMU) {
 }
 
 
-//Banking Functions
+//Banking Functions (Only the page table changes, nothing gets copied)
+static void MMUMapROMBank(MMU *MMU) {
+    uint8_t *Bank = MMU->ROMFile + 0x4000 * MMU->CurrentROMBank;
+    for (int page = 0x40; page <= 0x7F; page++) {
+        MMU->ReadPage[page] = Bank + ((page - 0x40) << 8);
+    }
+}
+static void MMUMapRAMBank(MMU *MMU) {
+    //Carts without RAM just use the 0xFF filled system memory
+    uint8_t *Bank = MMU->SystemMemory + 0xA000;
+    if (MMU->NumRAMBanks > 0) {
+        Bank = MMU->RAMFile + 0x2000 * MMU->CurrentRAMBank;
+    }
+    //While an RTC register is selected it replaces external RAM for reads
+    int RTC = (MMU->MBC == 0x10) && (MMU->RTCMode != 0);
+    for (int page = 0xA0; page <= 0xBF; page++) {
+        MMU->ReadPage[page] = RTC ? NULL : Bank + ((page - 0xA0) << 8);
+        MMU->WritePage[page] = Bank + ((page - 0xA0) << 8);
+    }
+}
 void MMUSwapROMBank(MMU *MMU, int bank) {
     bank = bank & (MMU->NumROMBanks-1);
     if (bank == 0) {
         bank = 1; //Prevent accesses to the first bank of ROM. Bank 0 is always at 0x0000 - 0x3FFF
     }
-    size_t BaseAddress = 0x4000 * bank;
-    // Copy the bank data into the system memory at 0x4000-0x7FFF
-    memcpy(MMU->SystemMemory + 0x4000, MMU->ROMFile + BaseAddress, 0x4000);
-    // Update the current ROM bank
     MMU->CurrentROMBank = bank;
+    MMUMapROMBank(MMU);
 }
 void MMUSwapRAMBank(MMU *MMU, int bank) {
-    //Copy Current Bank to the RAMFile Pointer
-    size_t CurrentBaseAddress = 0x2000 * MMU->CurrentRAMBank;
-    memcpy(MMU->RAMFile + CurrentBaseAddress, MMU->SystemMemory + 0xA000, 0x2000);
-    //Swap the RAM Bank into System Memory
-    size_t BaseAddress = 0x2000 * bank;
-    memcpy(MMU->SystemMemory + 0xA000, MMU->RAMFile + BaseAddress, 0x2000);
-    // Update the current RAM bank
-    MMU->CurrentRAMBank = bank;
+    MMU->CurrentRAMBank = bank % MMU->NumRAMBanks; //Wrap instead of running past the end of RAMFile
+    MMUMapRAMBank(MMU);
+}
+
+
+//Page Table
+void MMUMapPages(MMU *MMU) {
+    for (int page = 0; page < 0x100; page++) {
+        uint8_t *Memory = MMU->SystemMemory + (page << 8);
+        if (page >= 0xE0 && page <= 0xFD) {
+            Memory -= 0x2000; //Echo RAM
+        }
+        MMU->ReadPage[page] = Memory;
+        MMU->WritePage[page] = Memory;
+    }
+
+    //ROM Bank 0 and the switchable bank, writes to ROM are MBC commands
+    if (MMU->ROMFile != NULL) {
+        for (int page = 0x00; page <= 0x3F; page++) {
+            MMU->ReadPage[page] = MMU->ROMFile + (page << 8);
+        }
+        MMUMapROMBank(MMU);
+    }
+    for (int page = 0x00; page <= 0x7F; page++) {
+        MMU->WritePage[page] = NULL;
+    }
+
+    //External RAM
+    MMUMapRAMBank(MMU);
+
+    //VRAM, tile data writes always have to mark the tile dirty, the tile maps only while the PPU still has pixels to draw
+    for (int page = 0x80; page <= 0x97; page++) {
+        MMU->WritePage[page] = NULL;
+    }
+    MMUTrapVRAMWrites(MMU, MMU->VRAMTrap);
+
+    //Joypad, DIV reset, DMA and the scheduler hook all live here (HRAM shares the page, MMURead/MMUWrite handle it before the slow path)
+    MMU->ReadPage[0xFF] = NULL;
+    MMU->WritePage[0xFF] = NULL;
+}
+void MMUTrapVRAMWrites(MMU *MMU, uint8_t Trap) {
+    MMU->VRAMTrap = Trap;
+    for (int page = 0x98; page <= 0x9F; page++) {
+        MMU->WritePage[page] = Trap ? NULL : MMU->SystemMemory + (page << 8);
+    }
 }
 
 
-//Read Write functions for the CPU.
-uint8_t MMURead(MMU *MMU, uint16_t address) { 
+//Read Write functions for the CPU. (Only reached for pages MMUMapPages left unmapped, MMURead/MMUWrite handle the rest)
+uint8_t MMUReadSlow(MMU *MMU, uint16_t address) { 
     
     //RTC Functions
     if ((MMU->MBC == 0x10) && (address >= 0xA000 && address <= 0xBFFF)) {
         //RTC Register Locations
         if (MMU->RTCMode != 0) {
-            //Get system time
-            time_t t = time(NULL);
-            struct tm tm = *localtime(&t);
+            //Get system time, or the virtual clock (UTC, so it reads the same in every time zone) while one is set.
+            struct tm tm;
+            if (MMU->ClockRead != NULL) {
+                time_t t = (time_t)MMU->ClockRead(MMU->HookContext);
+                tm = *gmtime(&t);
+            }
+            else {
+                time_t t = time(NULL);
+                tm = *localtime(&t);
+            }
 
             //Split day into two 8 bit values
             uint8_t DayLower = tm.tm_mday & 0xFF;
@@ -164,23 +297,17 @@ uint8_t MMURead(MMU *MMU, uint16_t address) {
     /* PPU Timing too inaccurate to implement MODE 3 Blocking. */
 
     if (address == 0xFF00) {
-        uint8_t GamepadState = 0xFF;
+        uint8_t GamepadState = 0x0F;
 
         // Check action buttons
         if (!(MMU->SystemMemory[0xFF00] & 0x20)) {
-            if (!MMU->GameBoyController[4]) GamepadState &= ~0x01; // A
-            if (!MMU->GameBoyController[5]) GamepadState &= ~0x02; // B
-            if (!MMU->GameBoyController[6]) GamepadState &= ~0x08; // Start
-            if (!MMU->GameBoyController[7]) GamepadState &= ~0x04; // Select
+            GamepadState &= MMU->JoypadButtons;
         }
         // Check direction buttons
         if (!(MMU->SystemMemory[0xFF00] & 0x10)) {
-            if (!MMU->GameBoyController[0]) GamepadState &= ~0x04; // Up
-            if (!MMU->GameBoyController[1]) GamepadState &= ~0x08; // Down
-            if (!MMU->GameBoyController[2]) GamepadState &= ~0x02; // Left
-            if (!MMU->GameBoyController[3]) GamepadState &= ~0x01; // Right
+            GamepadState &= MMU->JoypadDirections;
         }
-        return GamepadState;
+        return 0xF0 | GamepadState;
     }
 
     if (address > 0xFFFF) {
@@ -189,7 +316,19 @@ uint8_t MMURead(MMU *MMU, uint16_t address) {
 
     return MMU->SystemMemory[address];
 }
-void MMUWrite(MMU *MMU, uint16_t address, uint8_t value) { 
+void MMUWriteSlow(MMU *MMU, uint16_t address, uint8_t value) { 
+    //VRAM, the PPU draws what it has gone past first while it has VRAM trapped, and tiles are only marked dirty when their data actually changes.
+    if (address >= 0x8000 && address <= 0x9FFF) {
+        if (MMU->VRAMTrap && MMU->WriteHook != NULL) {
+            MMU->WriteHook(MMU->HookContext, address);
+        }
+        if (MMU->SystemMemory[address] != value) {
+            MMUMarkTileDirty(MMU, address);
+            MMU->SystemMemory[address] = value;
+        }
+        return;
+    }
+
     if (address <= 0x1FFF) {
         return;
     }
@@ -206,6 +345,7 @@ void MMUWrite(MMU *MMU, uint16_t address, uint8_t value) {
             //Pokemon Annoyances
             if (value > 0x07) {
                 MMU->RTCMode = value;
+                MMUMapRAMBank(MMU);
                 return; 
             }
             else {
@@ -229,8 +369,17 @@ void MMUWrite(MMU *MMU, uint16_t address, uint8_t value) {
         return;
     }
     
+    //Let the scheduler run the component that owns this register up to now before it changes.
+    if (address >= 0xFF00 && address <= 0xFF7F && MMU->WriteHook != NULL) {
+        MMU->WriteHook(MMU->HookContext, address);
+    }
+    if (address >= 0xFF10 && address <= 0xFF3F && MMU->SoundWrite != NULL) {
+        MMU->SoundWrite(MMU->HookContext, address, value);
+        return;
+    }
+
     //Reset DIV Register
-    else if (address == 0xFF04) {
+    if (address == 0xFF04) {
         MMU->SystemMemory[0xFF04] = 0; 
     }
 
@@ -262,50 +411,40 @@ Theoretically both of these could have there own implementation, but they are de
 void DMATick(MMU *MMU) {
     //Transfer 160 bytes of data from DMA Source to 0xFE00-0xFEA0
     if (MMU->DMACount > 0) {
-        MMU->SystemMemory[MMU->DMADestination] = MMU->SystemMemory[MMU->DMASource];
+        MMU->SystemMemory[MMU->DMADestination] = *MMUDirect(MMU, MMU->DMASource);
         MMU->DMASource++;
         MMU->DMADestination++;
         MMU->DMACount--;
     }
     return;
 }
-//Update gamepad (Kept in this file instead of DMG.C because the CPU updates it after every instruction)
-void DMGUpdateGamePad(MMU *MMU) {
-    SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_QUIT) {
-            MMUSaveFile(MMU);
-            MMUFree(MMU);
-            exit(0);
-        }
-        if (event.type == SDL_KEYDOWN) {
-            for (int i = 0; i < 8; i++) {
-                if (event.key.keysym.sym == MMU->GameBoyKeyMap[i]) {
-                    MMU->GameBoyController[i] = 0;
-                }
-                if (event.key.keysym.sym == SDLK_ESCAPE) {
-                    MMUSaveFile(MMU);
-                    MMUFree(MMU);
-                    exit(0);
-                }
-                if (event.key.keysym.sym == SDLK_q) {
-                    RenderingSpeed--;
-                }
-                if (event.key.keysym.sym == SDLK_w) {
-                    RenderingSpeed++;
-                }
-                if (event.key.keysym.sym == SDLK_e) {
-                    RenderingSpeed = 13;
-                }
-            }
-        }
-        if (event.type == SDL_KEYUP) {
-            for (int i = 0; i < 8; i++) {
-                if (event.key.keysym.sym == MMU->GameBoyKeyMap[i]) {
-                    MMU->GameBoyController[i] = 1;
-                }
-            }
-        }
+//Rebuild the joypad snapshot, only done when the controller state actually gets sampled.
+void MMUUpdateJoypad(MMU *MMU) {
+    uint8_t Buttons = 0x0F;
+    uint8_t Directions = 0x0F;
+
+    if (!MMU->GameBoyController[4]) Buttons &= ~0x01; // A
+    if (!MMU->GameBoyController[5]) Buttons &= ~0x02; // B
+    if (!MMU->GameBoyController[6]) Buttons &= ~0x08; // Start
+    if (!MMU->GameBoyController[7]) Buttons &= ~0x04; // Select
+
+    if (!MMU->GameBoyController[0]) Directions &= ~0x04; // Up
+    if (!MMU->GameBoyController[1]) Directions &= ~0x08; // Down
+    if (!MMU->GameBoyController[2]) Directions &= ~0x02; // Left
+    if (!MMU->GameBoyController[3]) Directions &= ~0x01; // Right
+
+    //Joypad Interrupt, raised when a line of a selected group goes from high to low.
+    uint8_t Pressed = 0;
+    if (!(MMU->SystemMemory[0xFF00] & 0x20)) {
+        Pressed |= MMU->JoypadButtons & ~Buttons;
+    }
+    if (!(MMU->SystemMemory[0xFF00] & 0x10)) {
+        Pressed |= MMU->JoypadDirections & ~Directions;
+    }
+    if (Pressed) {
+        MMU->SystemMemory[0xFF0F] |= 0x10;
     }
-}
 
+    MMU->JoypadButtons = Buttons;
+    MMU->JoypadDirections = Directions;
+}
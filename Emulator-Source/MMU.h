@@ -2,6 +2,10 @@
 #define MMU_H
 
 #include <stdio.h>
+#include <stdint.h>
+#ifndef HEADLESS
+#include <SDL2/SDL.h>
+#endif
 
 typedef struct {
     /*Gameboy Memory Map
@@ -43,10 +47,25 @@ typedef struct {
 
     //KeyMap
     int GameBoyController[8]; //Up, Down, Left, Right, A, B, Start, Select
-    int GameBoyKeyMap[8] = {
-        SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT,
-        SDLK_z, SDLK_x, SDLK_a, SDLK_s
-    };
+    //Joypad snapshot read by 0xFF00, rebuilt by MMUUpdateJoypad (Active low, bits 0-3 as in P1)
+    uint8_t JoypadButtons; //Start, Select, B, A
+    uint8_t JoypadDirections; //Down, Up, Left, Right
+
+    //Called right before a write to an I/O register (0xFF00-0xFF7F) or trapped VRAM lands, so the scheduler can catch the owning component up first.
+    void (*WriteHook)(void *Context, uint16_t address);
+    void *HookContext;
+    //Takes over writes to the sound registers and Wave RAM (0xFF10-0xFF3F) right after WriteHook, so the APU sees every write (and trigger) as it happens.
+    void (*SoundWrite)(void *Context, uint16_t address, uint8_t value);
+    //Seconds since 1970 (UTC) the RTC registers read from, the host's clock (local time) is used while this is NULL.
+    int64_t (*ClockRead)(void *Context);
+    uint8_t VRAMTrap; //VRAM writes go through MMUWriteSlow (and the hook) while set
+    uint8_t TileDirty[384]; //Set for every tile (0x8000-0x97FF) written since the PPU last decoded it
+
+    //Page Table (256 byte pages)
+    //Ordinary pages point straight at their memory so a read or write is a single indexed access.
+    //NULL pages (MBC registers, RTC registers, I/O) go through MMUReadSlow/MMUWriteSlow instead.
+    uint8_t *ReadPage[0x100];
+    uint8_t *WritePage[0x100];
 } MMU;
 
 //Setup Functions
@@ -54,22 +73,88 @@ void MMUInit(MMU *MMU); //Creates space for ROM Data.
 void MMUFree(MMU *MMU); //Frees the space for ROM Data.
 
 //Load File Data Functions
-void MMULoadFile(MMU *MMU); //Loads the ROM and RAM data from the given file, and also loads the first two bans of ROM and the first external RAM bank into the system memory.
+uint8_t *MMUMapROM(const char *Path, size_t *Size); //Maps the ROM file read-only (Paged in lazily), returns NULL if it can't be opened.
+//The one mapping is shared by every instance, so nothing may write through ROMFile (Which is why MMUDirectWrite drops ROM stores).
+void MMUUnmapROM(uint8_t *ROM, size_t Size);
+void MMULoadFile(MMU *MMU); //Points ROMFile at the ROM mapped by ReadROMHeader and loads the RAM data, the banks are read straight out of those.
 void MMUSaveFile(MMU *MMU); //Saves the data in the RAMFile Pointer to the Given Save File.
 
 
 //MBC Functions
-void MMUSwapROMBank(MMU *MMU, int bank); //Swaps selected ROM Bank into the system memory.
-void MMUSwapRAMBank(MMU *MMU, int bank); //Swaps selected RAM Bank into the system memory.
+void MMUSwapROMBank(MMU *MMU, int bank); //Maps the selected ROM Bank to 0x4000-0x7FFF (Pointer update, no copy).
+void MMUSwapRAMBank(MMU *MMU, int bank); //Maps the selected RAM Bank to 0xA000-0xBFFF (Pointer update, no copy).
+
+//Page Table Functions
+void MMUMapPages(MMU *MMU); //Rebuilds the page table, needed after the RTC mode changes or after an MMU has been copied.
+void MMUTrapVRAMWrites(MMU *MMU, uint8_t Trap); //Unmaps the tile maps for writes (or maps them back), set by the PPU while it has a line left to draw. Tile data is never mapped for writes.
 
 //Read and Write Functions
-uint8_t MMURead(MMU *MMU, uint16_t address); //Reads a byte from the given address in the system memory.
-void MMUWrite(MMU *MMU, uint16_t address, uint8_t value); //Writes a byte to the given address in the system memory.
+uint8_t MMUReadSlow(MMU *MMU, uint16_t address); //Handles reads from pages that aren't mapped (RTC registers, Joypad, I/O).
+void MMUWriteSlow(MMU *MMU, uint16_t address, uint8_t value); //Handles writes to pages that aren't mapped (MBC registers, I/O, trapped VRAM).
+
+//Reads a byte from the given address in the system memory.
+static inline uint8_t MMURead(MMU *MMU, uint16_t address) {
+    uint8_t *Page = MMU->ReadPage[address >> 8];
+    if (Page != NULL) {
+        return Page[address & 0xFF];
+    }
+    //HRAM shares the I/O page, but it's plain memory and holds the hottest stacks and scratch variables, so it skips the slow path.
+    if (address >= 0xFF80 && address != 0xFFFF) {
+        return MMU->SystemMemory[address];
+    }
+    return MMUReadSlow(MMU, address);
+}
+
+//Writes a byte to the given address in the system memory.
+static inline void MMUWrite(MMU *MMU, uint16_t address, uint8_t value) {
+    uint8_t *Page = MMU->WritePage[address >> 8];
+    if (Page != NULL) {
+        Page[address & 0xFF] = value;
+        return;
+    }
+    if (address >= 0xFF80 && address != 0xFFFF) {
+        MMU->SystemMemory[address] = value;
+        return;
+    }
+    MMUWriteSlow(MMU, address, value);
+}
+
+//Where a byte lives for code that skips MMURead/MMUWrite (DMA reads), no MBC, RTC, echo or I/O handling.
+//ROM and external RAM come out of the current banks (WritePage, since ReadPage is unmapped while an RTC register is selected).
+static inline uint8_t *MMUDirect(MMU *MMU, uint16_t address) {
+    if (address < 0x8000) {
+        return MMU->ReadPage[address >> 8] + (address & 0xFF);
+    }
+    if (address >= 0xA000 && address <= 0xBFFF) {
+        return MMU->WritePage[address >> 8] + (address & 0xFF);
+    }
+    return MMU->SystemMemory + address;
+}
+
+//Marks the tile at the given address for the PPU to decode again, for anything that changes tile data (0x8000-0x97FF).
+static inline void MMUMarkTileDirty(MMU *MMU, uint16_t address) {
+    if (address >= 0x8000 && address <= 0x97FF) {
+        MMU->TileDirty[(address - 0x8000) >> 4] = 1;
+    }
+}
+
+//Stores a byte without going through the MBC or I/O handling (the interrupt push). ROM can't be written, so those bytes are dropped
+//instead of landing in the ROM image every instance shares. Trapped VRAM still flushes the line being drawn first, like MMUWriteSlow.
+static inline void MMUDirectWrite(MMU *MMU, uint16_t address, uint8_t value) {
+    if (address < 0x8000) {
+        return;
+    }
+    if (address <= 0x9FFF && MMU->VRAMTrap && MMU->WriteHook != NULL) {
+        MMU->WriteHook(MMU->HookContext, address);
+    }
+    *MMUDirect(MMU, address) = value;
+    MMUMarkTileDirty(MMU, address);
+}
 
 //DMA Functions
 void DMATick(MMU *MMU); //Ticks the MMU, and if a DMA transfer is in progress, it will transfer the next byte of data.
 
-//Update Gamepad Functions (Kept in this file because the CPU uses it for HALT and STOP instructions)
-void DMGUpdateGamePad(MMU *MMU);
+//Update Gamepad Functions (The buttons come in through DMGSetButtons once per frame, from whoever runs the core)
+void MMUUpdateJoypad(MMU *MMU); //Rebuilds the 0xFF00 snapshot from GameBoyController and raises the joypad interrupt on new presses.
 
 #endif // MMU_H
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Movie.h"
+#include "State.h"
+#include "Hash.h"
+
+extern uint8_t *ROMImage;
+extern size_t ROMImageSize;
+extern int RAMSize;
+
+uint64_t MovieROMHash(void) {
+    return HashBytes(ROMImage, ROMImageSize, 0);
+}
+
+void MovieInit(Movie *Movie) {
+    memset(Movie, 0, sizeof(*Movie));
+    Movie->Mode = MOVIE_OFF;
+}
+
+void MovieFree(Movie *Movie) {
+    free(Movie->Start);
+    free(Movie->Inputs);
+    MovieInit(Movie);
+}
+
+void MovieRecord(Movie *Movie, DMG *DMG, uint32_t Start, int64_t Clock) {
+    MovieFree(Movie);
+    memcpy(Movie->Header.Magic, MOVIE_MAGIC, 8);
+    Movie->Header.Version = MOVIE_VERSION;
+    Movie->Header.ROMHash = MovieROMHash();
+    Movie->Header.Clock = Clock;
+    Movie->Header.Start = Start;
+
+    if (Start == MOVIE_START_POWER_ON) {
+        //Everything else at power on comes from the ROM, only the battery backed RAM can differ between runs.
+        Movie->Header.StartSize = (uint32_t)RAMSize + 0x2000;
+        Movie->Start = (uint8_t *)malloc(Movie->Header.StartSize);
+        memcpy(Movie->Start, DMG->DMG_MMU.RAMFile, RAMSize);
+        memcpy(Movie->Start + RAMSize, DMG->DMG_MMU.SystemMemory + 0xA000, 0x2000);
+    }
+    else {
+        uint8_t *Raw = (uint8_t *)malloc(StateRawSize(DMG));
+        Movie->Start = (uint8_t *)malloc(StateMaxSize(DMG));
+        Movie->Header.StartSize = (uint32_t)StateSave(DMG, Raw, NULL, Movie->Start);
+        free(Raw);
+    }
+
+    DMGSetClock(DMG, Clock);
+    Movie->Mode = MOVIE_RECORDING;
+}
+
+void MovieAddFrame(Movie *Movie, uint8_t Buttons) {
+    if (Movie->Header.Frames == Movie->Capacity) {
+        Movie->Capacity = (Movie->Capacity > 0) ? Movie->Capacity * 2 : 4096;
+        Movie->Inputs = (uint8_t *)realloc(Movie->Inputs, Movie->Capacity);
+    }
+    Movie->Inputs[Movie->Header.Frames++] = Buttons;
+}
+
+int MovieSave(Movie *Movie, const char *Path) {
+    FILE *File = fopen(Path, "wb");
+    if (File == NULL) {
+        return -1;
+    }
+    int Result = (fwrite(&Movie->Header, sizeof(MovieHeader), 1, File) == 1 &&
+                  fwrite(Movie->Start, 1, Movie->Header.StartSize, File) == Movie->Header.StartSize &&
+                  fwrite(Movie->Inputs, 1, Movie->Header.Frames, File) == Movie->Header.Frames) ? 0 : -1;
+    fclose(File);
+    return Result;
+}
+
+int MovieLoad(Movie *Movie, const char *Path) {
+    MovieFree(Movie);
+    FILE *File = fopen(Path, "rb");
+    if (File == NULL) {
+        printf("Error: Could not open %s\n", Path);
+        return -1;
+    }
+
+    MovieHeader *Header = &Movie->Header;
+    if (fread(Header, sizeof(MovieHeader), 1, File) != 1 || memcmp(Header->Magic, MOVIE_MAGIC, 8) != 0 || Header->Version != MOVIE_VERSION) {
+        printf("Error: %s is not a movie\n", Path);
+        fclose(File);
+        MovieInit(Movie);
+        return -1;
+    }
+    if (Header->ROMHash != MovieROMHash()) {
+        printf("Error: %s was recorded on a different ROM\n", Path);
+        fclose(File);
+        MovieInit(Movie);
+        return -1;
+    }
+
+    Movie->Start = (uint8_t *)malloc(Header->StartSize);
+    Movie->Inputs = (uint8_t *)malloc((Header->Frames > 0) ? Header->Frames : 1);
+    Movie->Capacity = Header->Frames;
+    if (fread(Movie->Start, 1, Header->StartSize, File) != Header->StartSize || fread(Movie->Inputs, 1, Header->Frames, File) != Header->Frames) {
+        printf("Error: %s is cut short\n", Path);
+        fclose(File);
+        MovieFree(Movie);
+        return -1;
+    }
+    fclose(File);
+    return 0;
+}
+
+int MoviePlay(Movie *Movie, DMG *DMG) {
+    if (Movie->Header.Start == MOVIE_START_POWER_ON) {
+        if (Movie->Header.StartSize != (uint32_t)RAMSize + 0x2000) {
+            return -1;
+        }
+        memcpy(DMG->DMG_MMU.RAMFile, Movie->Start, RAMSize);
+        memcpy(DMG->DMG_MMU.SystemMemory + 0xA000, Movie->Start + RAMSize, 0x2000);
+    }
+    else {
+        uint8_t *Raw = (uint8_t *)malloc(StateRawSize(DMG));
+        int Result = StateLoad(DMG, Raw, NULL, Movie->Start, Movie->Header.StartSize);
+        free(Raw);
+        if (Result != 0) {
+            return -1; //Made by another build
+        }
+    }
+
+    DMGSetClock(DMG, Movie->Header.Clock);
+    Movie->Position = 0;
+    Movie->Mode = MOVIE_PLAYING;
+    return 0;
+}
+
+int MovieNextFrame(Movie *Movie, uint8_t *Buttons) {
+    if (Movie->Mode != MOVIE_PLAYING || Movie->Position >= Movie->Header.Frames) {
+        Movie->Mode = MOVIE_OFF;
+        return 0;
+    }
+    *Buttons = Movie->Inputs[Movie->Position++];
+    return 1;
+}
+
+int MovieBack(Movie *Movie, int Frames) {
+    uint32_t *Frame = (Movie->Mode == MOVIE_RECORDING) ? &Movie->Header.Frames : &Movie->Position;
+    if ((uint32_t)Frames > *Frame) {
+        *Frame = 0;
+        return -1;
+    }
+    *Frame -= (uint32_t)Frames;
+    return 0;
+}
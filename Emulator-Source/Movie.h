@@ -0,0 +1,65 @@
+#ifndef MOVIE_H
+#define MOVIE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "DMG.h"
+
+/*
+    Movie (Input recording and playback)
+    A movie is where a session started and the buttons held for every DMGRunFrame after it. The core is deterministic, so running the same
+    frames with the same buttons from the same start always ends in the same machine, down to the last bit. The one outside input left is the
+    MBC3 clock, so the RTC reads a virtual clock (DMGSetClock) from the time in the header while a movie is recorded or played.
+
+    A movie starts either at power on, storing only the cartridge RAM the game found there (Which any build can play), or from a save state
+    (Which only plays on the build that made it, see State.h). The ROM's hash is kept so a movie can't be played on a different game.
+
+    File layout: MovieHeader, StartSize bytes of start data, then Frames bytes of input (One per frame, GameBoyController order, 1 = pressed).
+*/
+#define MOVIE_MAGIC "EMOOMOVI"
+#define MOVIE_VERSION 1
+
+#define MOVIE_START_POWER_ON 0 //Start data is the cartridge RAM (RAMFile, then 0xA000-0xBFFF for carts without RAM)
+#define MOVIE_START_STATE 1 //Start data is a save state (StateSave without a base)
+
+//What the emulator is doing with the movie given on the command line (--record or --play).
+#define MOVIE_OFF 0
+#define MOVIE_RECORDING 1
+#define MOVIE_PLAYING 2
+
+typedef struct {
+    char Magic[8];
+    uint32_t Version;
+    uint32_t Frames;
+    uint64_t ROMHash; //HashBytes of the ROM file
+    int64_t Clock; //Virtual RTC time at the start (Seconds since 1970, UTC)
+    uint32_t Start; //MOVIE_START_POWER_ON or MOVIE_START_STATE
+    uint32_t StartSize; //Bytes of start data
+} MovieHeader;
+
+typedef struct {
+    MovieHeader Header;
+    uint8_t *Start;
+    uint8_t *Inputs;
+    uint32_t Capacity; //Frames Inputs has room for
+    uint32_t Position; //Next frame to play back
+    int Mode; //MOVIE_RECORDING or MOVIE_PLAYING, back to MOVIE_OFF once playback is over
+} Movie;
+
+uint64_t MovieROMHash(void); //Hash of the loaded ROM file.
+void MovieInit(Movie *Movie); //An empty movie (MOVIE_OFF) to record or load into.
+
+//Starts recording from the machine as it is now (Right after DMGInit for MOVIE_START_POWER_ON), with the RTC reading Clock from here on.
+void MovieRecord(Movie *Movie, DMG *DMG, uint32_t Start, int64_t Clock);
+void MovieAddFrame(Movie *Movie, uint8_t Buttons); //Records the buttons a frame that just ran was given.
+int MovieSave(Movie *Movie, const char *Path); //Returns 0 on success.
+
+int MovieLoad(Movie *Movie, const char *Path); //Reads a movie of the loaded ROM, returns -1 (and says why) if there isn't one.
+int MoviePlay(Movie *Movie, DMG *DMG); //Puts a freshly initialised DMG at the movie's start, returns -1 if the start state doesn't load.
+int MovieNextFrame(Movie *Movie, uint8_t *Buttons); //Buttons for the next frame, returns 0 once the movie is over.
+
+//Takes the last Frames frames back after a rewind, dropping them from a recording or playing them again. Returns -1 if that goes back past the start.
+int MovieBack(Movie *Movie, int Frames);
+void MovieFree(Movie *Movie);
+
+#endif // MOVIE_H
@@ -1,15 +1,25 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <SDL2/SDL.h>
+#include <string.h>
 #include "MMU.h"
 #include "PPU.h"
 
-extern SDL_Window *window;
-extern SDL_Renderer *renderer;
-extern SDL_Texture* texture;
-extern int SCALE;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PPU_DECODE_X86
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PPU_DECODE_NEON
+#endif
+
 extern int DMGPalette[12];
-extern int RenderingSpeed;
+
+static void PPUFinishLine(PPU *PPU, MMU *MMU);
+
+//Tile row decoder picked by PPUSelectDecoder (See Tile Row Decoders below).
+typedef void (*PPURowDecoder)(uint8_t LowByte, uint8_t HighByte, uint8_t *Indices);
+static PPURowDecoder PPUDecodeRow = NULL;
+static const char *PPUDecoderName = "Scalar";
 
 /*
     LCDC = MMU->SystemMemory[0xFF40]; //LCD Control Register
@@ -30,8 +40,10 @@ void PPUTick(PPU *PPU, MMU *MMU) {
 
     //Check if PPU is turned on (LCDC Bit 7)
     if ((MMU->SystemMemory[0xFF40] & (1 << 7)) == 0) {
+        PPUFinishLine(PPU, MMU);
         PPU->CurrentX = 0;
         PPU->WindowLineCounter = 0;
+        PPU->SkipFrame = PPU->SkipDrawing;
         MMU->SystemMemory[0xFF44] = 0;
         PPU->Mode3Length = 252;
         MMU->SystemMemory[0xFF41] = (MMU->SystemMemory[0xFF41] & ~0x03); //Set Mode to 0       
@@ -60,8 +72,8 @@ void PPUTick(PPU *PPU, MMU *MMU) {
                 MMU->SystemMemory[0xFF0F] |= 0x02; //Set STAT Interrupt
             }
 
-            // Render complete frame at VBlank
-            PPUPushPixel(PPU);
+            //The frame is complete at VBlank, whoever runs the core hands it off from here
+            PPU->FrameReady = 1;
         }
 
         MMU->SystemMemory[0xFF41] = (MMU->SystemMemory[0xFF41] & 0xFC) | (1 & 0x03);  //Set Mode to VBlank
@@ -69,6 +81,7 @@ void PPUTick(PPU *PPU, MMU *MMU) {
         PPU->CurrentX++; //Increment X
 
         if (PPU->CurrentX == 456) { //End of Scanline
+            PPUFinishLine(PPU, MMU);
             //Move to next scanline
             PPU->CurrentX = 0;
             PPU->NumSpritePixels = 0; //Reset Sprite Pixel Count
@@ -80,6 +93,7 @@ void PPUTick(PPU *PPU, MMU *MMU) {
         if (LY > 153) { //End of VBlank (4560 Cycles)
             PPU->CurrentX = 0;
             PPU->WindowLineCounter = 0;
+            PPU->SkipFrame = PPU->SkipDrawing;
             LY = 0;
             MMU->SystemMemory[0xFF44] = LY;
             PPU->Mode3Length = 252;
@@ -109,11 +123,19 @@ void PPUTick(PPU *PPU, MMU *MMU) {
 
         MMU->SystemMemory[0xFF41] = (MMU->SystemMemory[0xFF41] & 0xFC) | (3 & 0x03);  //Set Mode to Drawing Pixels (This way the MMU can block off access to VRAM)
 
-        if (PPU->CurrentX < 240) { //Draw only the 160 pixels, don't draw for the rest of the MODE 3 time.
-            PPUDraw(PPU, MMU, (PPU->CurrentX - 80), LY);
+        //Draw only the 160 pixels, don't draw for the rest of the MODE 3 time.
+        //The pixels are drawn in batches by PPUFlush, right before a register or VRAM write could change them and once the line is done.
+        //VRAM writes are trapped until then so they get the chance to flush.
+        if (PPU->CurrentX < 240 && !PPU->Drawing && !PPU->SkipFrame) {
+            PPU->Drawing = 1;
+            PPU->DrawnX = PPU->CurrentX - 80;
+            MMUTrapVRAMWrites(MMU, 1);
         }
    
         PPU->CurrentX += 1;
+        if (PPU->CurrentX == 240) {
+            PPUFinishLine(PPU, MMU);
+        }
         return;
     }
     
@@ -131,6 +153,7 @@ void PPUTick(PPU *PPU, MMU *MMU) {
     }
 
     if (PPU->CurrentX == 456) { //End of Scanline
+        PPUFinishLine(PPU, MMU);
         //if window pixels were drawn this scanline increment 
         if (PPU->haswindow > 0) {
             PPU->WindowLineCounter++;
@@ -146,6 +169,71 @@ void PPUTick(PPU *PPU, MMU *MMU) {
     }
 }
 
+/*Runs the PPU for the given number of ticks.
+  Outside of the OAM search, the start and end of drawing and scanline/VBlank boundaries a tick only rewrites the mode bits, repeats the LYC check and moves X along.
+  Those runs get a single PPUTick and the rest of the run is kept in IdleTicks and skipped over, everything else still goes through PPUTick one dot at a time.
+  IdleTicks has to be cleared whenever LCDC, STAT, LY, LYC or the STAT interrupt flag get changed by someone else. */
+void PPUAdvance(PPU *PPU, MMU *MMU, int Ticks) {
+    while (Ticks > 0) {
+        if (PPU->IdleTicks > 0) {
+            int Skip = (PPU->IdleTicks < Ticks) ? PPU->IdleTicks : Ticks;
+            if (MMU->SystemMemory[0xFF40] & 0x80) {
+                PPU->CurrentX += Skip;
+            }
+            PPU->IdleTicks -= Skip;
+            Ticks -= Skip;
+            continue;
+        }
+
+        int Run = PPUIdleRun(PPU, MMU);
+        PPUTick(PPU, MMU);
+        if (Run > 1) {
+            PPU->IdleTicks = Run - 1;
+        }
+        Ticks--;
+    }
+}
+
+//Ticks until the PPU next does something visible (0 means the very next tick).
+int PPUNextEvent(PPU *PPU, MMU *MMU) {
+    return PPU->IdleTicks;
+}
+
+//Number of upcoming ticks (starting with the current one) that would do nothing but the per dot bookkeeping.
+int PPUIdleRun(PPU *PPU, MMU *MMU) {
+    int X = PPU->CurrentX;
+    uint8_t LY = MMU->SystemMemory[0xFF44];
+
+    if ((MMU->SystemMemory[0xFF40] & 0x80) == 0) {
+        return 70224; //Nothing changes until LCDC gets written, which wakes the PPU up
+    }
+    if (LY >= 144) {
+        if ((LY == 144 && X == 0) || X >= 455 || LY > 153) {
+            return 0; //VBlank Interrupt, End of Scanline, End of VBlank (LY written past 153)
+        }
+        return 455 - X;
+    }
+    if (X == 0) {
+        return 0;
+    }
+    if (X < 80) {
+        return 80 - X;
+    }
+    if (X < 239) {
+        return 239 - X; //Drawing, PPUFlush draws the pixels
+    }
+    if (X == 239) {
+        return 0; //Last pixel, finishes the line
+    }
+    if (X < PPU->Mode3Length) {
+        return PPU->Mode3Length - X;
+    }
+    if (X == PPU->Mode3Length || X >= 456) {
+        return 0; //HBlank STAT Interrupt, End of Scanline
+    }
+    return 456 - X;
+}
+
 void PPUInit(PPU *PPU, MMU *MMU) {
     //Initialize the PPU Registers
     MMU->SystemMemory[0xFF40] = 0x91; //LCDC
@@ -161,21 +249,30 @@ void PPUInit(PPU *PPU, MMU *MMU) {
     MMU->SystemMemory[0xFF4B] = 0x00; //WX
 
     PPU->CurrentX = 252;
-    PPU->BackgroundPixel = 0;
-    PPU->WindowPixel = 0;
     PPU->Mode3Length = 252;
     PPU->NumSpritePixels = 0;
     PPU->CurrentX = 0;
     PPU->WindowLineCounter = 0;
     PPU->haswindow = 0;
     PPU->ScanlineDelay = 0; //Delay every 9th scanline.
+    PPU->FrameReady = 0;
+    PPU->IdleTicks = 0;
+    if (PPUDecodeRow == NULL) {
+        PPUSelectDecoder();
+    }
+    PPU->Drawing = 0;
+    PPU->DrawnX = 0;
+    PPU->SkipDrawing = 0;
+    PPU->SkipFrame = 0;
+
+    //Resolve the 12 palette entries up front, pixels are stored as the final 0xRRGGBB colour
+    for (int i = 0; i < 12; i++) {
+        PPU->PaletteRGB[i] = DMGPalette[i];
+    }
 
-    for (int i = 0; i < 160; i++)
-    {
-        for (int j = 0; j < 144; j++)
-        {
-            PPU->GameBoyDisplay[i][j] = 0;
-        }
+    PPU->Framebuffer = &PPU->GameBoyDisplay[0][0];
+    for (int i = 0; i < 160 * 144; i++) {
+        PPU->Framebuffer[i] = PPU->PaletteRGB[0];
     }
 
     return;
@@ -215,233 +312,277 @@ void PPUOAMSearch(PPU *PPU, MMU *MMU, uint8_t LY) {
     }
 }
 
-/*Update Background or Window Maps
-    This function essentially updates the background and window map that the Gameboy uses to render tiles based on the current pixel.
+/*Tile Row Decoders
+  Turn the two bitplane bytes of a tile row into the 2 bit colour index of each of its 8 pixels (left to right), which is what the tile cache holds.
+  The palettes are applied when the cached rows are drawn, so the decoders never see them.
+  The fastest one the CPU supports is picked by PPUSelectDecoder, build with -DPPU_DECODE_SCALAR to always use the plain loop.
 */
-void PPUUpdateMap(PPU *PPU, MMU *MMU, uint8_t MODE, uint8_t x, uint8_t y) { //0 for background, 1 for Window
-
-    
-    //Initialize Variables
-    uint16_t TMAPLocationStart, TDATALocationStart, TileLocation;
-    uint8_t ChoiceMask;
-    
-    uint8_t BackgroundPortX = MMU->SystemMemory[0xFF43];
-    uint8_t BackgroundPortY = MMU->SystemMemory[0xFF42];
-    
-    int8_t WindowPortX = MMU->SystemMemory[0xFF4B]-7;
-    //Ensure handling of Negative Numbers
-    if (WindowPortX < 0) {
-            WindowPortX = 0;
+static void PPUDecodeRowScalar(uint8_t LowByte, uint8_t HighByte, uint8_t *Indices) {
+    for (int i = 0; i < 8; i++) {
+        Indices[i] = ((HighByte >> (7 - i)) & 1) << 1 | ((LowByte >> (7 - i)) & 1);
     }
-    int8_t WindowPortY = MMU->SystemMemory[0xFF4A];
+}
 
+#if defined(PPU_DECODE_X86)
+//Spreads the bitplanes out to one byte per pixel (0-3) in the low 8 lanes.
+__attribute__((target("sse2")))
+static void PPUDecodeRowSSE2(uint8_t LowByte, uint8_t HighByte, uint8_t *Indices) {
+    const __m128i Bits = _mm_setr_epi8((char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i Low = _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8((char)LowByte), Bits), Bits);
+    __m128i High = _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8((char)HighByte), Bits), Bits);
+    _mm_storel_epi64((__m128i *)Indices, _mm_or_si128(_mm_and_si128(Low, _mm_set1_epi8(1)), _mm_and_si128(High, _mm_set1_epi8(2))));
+}
+#endif
+
+#if defined(PPU_DECODE_NEON)
+static void PPUDecodeRowNEON(uint8_t LowByte, uint8_t HighByte, uint8_t *Indices) {
+    static const uint8_t BitMasks[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+    uint8x8_t Bits = vld1_u8(BitMasks);
+    uint8x8_t Low = vtst_u8(vdup_n_u8(LowByte), Bits);
+    uint8x8_t High = vtst_u8(vdup_n_u8(HighByte), Bits);
+    vst1_u8(Indices, vorr_u8(vand_u8(Low, vdup_n_u8(1)), vand_u8(High, vdup_n_u8(2))));
+}
+#endif
+
+//Checks a decoder against the scalar loop for every pair of bitplane bytes.
+static int PPUDecoderMatches(PPURowDecoder Decoder) {
+    uint8_t Expected[8];
+    uint8_t Result[8];
+
+    for (int Plane = 0; Plane < 0x10000; Plane++) {
+        PPUDecodeRowScalar(Plane & 0xFF, Plane >> 8, Expected);
+        Decoder(Plane & 0xFF, Plane >> 8, Result);
+        if (memcmp(Expected, Result, 8) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
 
-    //Calculate the actualX and Y value of the pixel based on the MODE
-    uint8_t pixelX;
-    uint8_t pixelY;
+void PPUSelectDecoder(void) {
+    PPUDecodeRow = PPUDecodeRowScalar;
+    PPUDecoderName = "Scalar";
 
-    if (MODE == 0) {
-        ChoiceMask = 0x08; //Affects the Background Tile Map Location
-        pixelX = (x + BackgroundPortX) % 256;
-        pixelY = (y + BackgroundPortY) % 256;
+#if !defined(PPU_DECODE_SCALAR)
+#if defined(PPU_DECODE_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2") && PPUDecoderMatches(PPUDecodeRowSSE2)) {
+        PPUDecodeRow = PPUDecodeRowSSE2;
+        PPUDecoderName = "SSE2";
     }
-    else {
-        ChoiceMask = 0x40; //Affects the Window Tile Map Location
-        pixelX = (x + WindowPortX) % 256;
-        WindowPortY = PPU->WindowLineCounter;
-        pixelY = PPU->WindowLineCounter;
+#elif defined(PPU_DECODE_NEON)
+    if (PPUDecoderMatches(PPUDecodeRowNEON)) {
+        PPUDecodeRow = PPUDecodeRowNEON;
+        PPUDecoderName = "NEON";
     }
+#endif
+#endif
+}
 
-    //Check which tile data and map to use
-    if (MMU->SystemMemory[0xFF40] & 0x10) {
-        TDATALocationStart = 0x8000;
-    } else {
-        TDATALocationStart = 0x8800;
+const char *PPUDecoder(void) {
+    return PPUDecoderName;
+}
+
+/*Tile Cache
+    Every tile in 0x8000-0x97FF is kept decoded into 2 bit indices, as is and flipped horizontally, rows are numbered Tile * 8 + Row.
+    MMUWriteSlow marks a tile dirty when its data changes and it gets decoded again the next time one of its rows is used.
+*/
+static void PPUDecodeTile(PPU *PPU, MMU *MMU, int Tile) {
+    MMU->TileDirty[Tile] = 0;
+    for (int Row = Tile * 8; Row < Tile * 8 + 8; Row++) {
+        uint16_t TileLocation = 0x8000 + (Row * 2);
+        PPUDecodeRow(MMU->SystemMemory[TileLocation], MMU->SystemMemory[TileLocation + 1], PPU->TileRows[Row]);
+        for (int i = 0; i < 8; i++) {
+            PPU->FlippedTileRows[Row][i] = PPU->TileRows[Row][7 - i];
+        }
     }
+}
 
-    if (MMU->SystemMemory[0xFF40] & ChoiceMask) {
-        TMAPLocationStart = 0x9C00;
-    } else {
-        TMAPLocationStart = 0x9800;
+static inline const uint8_t *PPUTileRow(PPU *PPU, MMU *MMU, int Row, int Flipped) {
+    if (MMU->TileDirty[Row >> 3]) {
+        PPUDecodeTile(PPU, MMU, Row >> 3);
     }
-    
-    //Checks which tile it is on, on the 32x32 grid
-    uint8_t tileX = (pixelX / 8) % 32; 
-    uint8_t tileY = (pixelY / 8) % 32;
-    uint8_t DisplaypixelX = pixelX % 8;
-    uint8_t DisplaypixelY = pixelY % 8;
+    return Flipped ? PPU->FlippedTileRows[Row] : PPU->TileRows[Row];
+}
 
+//Row of the background or window tile in the given tile map entry.
+static inline const uint8_t *PPUMapTileRow(PPU *PPU, MMU *MMU, uint16_t MapLocation, uint8_t Row) {
+    uint8_t MemLocation = MMU->SystemMemory[MapLocation];
+
+    //Check which tile data to use
+    if (MMU->SystemMemory[0xFF40] & 0x10) {
+        return PPUTileRow(PPU, MMU, MemLocation * 8 + Row, 0); //0x8000
+    } 
+    return PPUTileRow(PPU, MMU, (256 + (int8_t)MemLocation) * 8 + Row, 0); //0x9000
+}
 
-    //Find tile and memory locations
-    uint8_t MemLocation; 
-    uint16_t OFFSET;
-    uint16_t TIleIndexLoc;
+//Splits a palette register into the colour for each index.
+static inline void PPUPaletteColors(uint8_t Palette, uint8_t Offset, uint8_t *Colors) {
+    for (int i = 0; i < 4; i++) {
+        Colors[i] = ((Palette >> (i * 2)) & 0x03) + Offset;
+    }
+}
 
-    if (MODE == 0) {
-        OFFSET = ((32 * (PPU->WindowLineCounter / 8) + (x+7-(BackgroundPortX+7))/8)  & 0x3FFF);
-        TIleIndexLoc = TMAPLocationStart + ((32 * (PPU->WindowLineCounter / 8) + (x+7-(BackgroundPortX+7))/8)  & 0x3FFF);
-        MemLocation = MMU->SystemMemory[TMAPLocationStart  + tileX + tileY * 32];
+/*PPU Draw (Draws the pixels from Start up to End on scanline y)
+    The background, window and sprites come out of the tile cache a row at a time, then the sprites go over the background and window pixel by pixel.
+*/
+void PPUDraw(PPU *PPU, MMU *MMU, int Start, int End, int y) {
+    uint8_t LCDC = MMU->SystemMemory[0xFF40];
+    uint8_t LinePixels[160]; //0xFF where neither the background nor the window has drawn anything
+    uint8_t WindowPixels[160];
+    uint8_t Colors[4];
+    uint32_t *Line = PPU->Framebuffer + y * 160;
+
+    PPUPaletteColors(MMU->SystemMemory[0xFF47], 0, Colors);
+
+    for (int x = Start; x < End; x++) {
+        LinePixels[x] = 0xFF;
+        WindowPixels[x] = 0;
     }
-    else {
-        OFFSET = ((32 * (PPU->WindowLineCounter / 8) + (x+7-(WindowPortY+7))/8)  & 0x3FFF);
-        TIleIndexLoc = TMAPLocationStart + ((32 * (PPU->WindowLineCounter / 8) + (x+7-(WindowPortY+7))/8)  & 0x3FFF);
-        MemLocation = MMU->SystemMemory[TMAPLocationStart + ((32 * (PPU->WindowLineCounter / 8) + (x+7-(WindowPortX+7))/8)  & 0x3FFF)];
+
+    //Draw Background.
+    if (LCDC & 0x01) {
+        uint8_t BackgroundPortX = MMU->SystemMemory[0xFF43];
+        uint8_t BackgroundPortY = MMU->SystemMemory[0xFF42];
+        uint16_t TMAPLocationStart = (LCDC & 0x08) ? 0x9C00 : 0x9800;
+        uint8_t pixelY = (y + BackgroundPortY) % 256;
+        uint16_t MapRow = TMAPLocationStart + ((pixelY / 8) % 32) * 32;
+
+        int x = Start;
+        while (x < End) {
+            uint8_t pixelX = (x + BackgroundPortX) % 256;
+            const uint8_t *Indices = PPUMapTileRow(PPU, MMU, MapRow + (pixelX / 8) % 32, pixelY % 8);
+            for (int i = pixelX % 8; i < 8 && x < End; i++, x++) {
+                LinePixels[x] = Colors[Indices[i]];
+            }
+        }
     }
 
-    if (TDATALocationStart == 0x8000) {
-        TileLocation = TDATALocationStart + (MemLocation * 16);
-    } 
-    else {
-        TileLocation = 0x9000 + ((int8_t)MemLocation * 16);
+    // Check if the window is enabled and should be drawn on this scanline
+    if ((LCDC & 0x20) && y >= MMU->SystemMemory[0xFF4A]) {
+        int WindowStart = MMU->SystemMemory[0xFF4B] - 7;
+        int8_t WindowPortX = MMU->SystemMemory[0xFF4B] - 7;
+        //Ensure handling of Negative Numbers
+        if (WindowPortX < 0) {
+            WindowPortX = 0;
+        }
+        uint16_t TMAPLocationStart = (LCDC & 0x40) ? 0x9C00 : 0x9800;
+        uint8_t WindowRow = PPU->WindowLineCounter;
+
+        int x = (Start > WindowStart) ? Start : WindowStart;
+        while (x < End) {
+            //The tile is picked by x - WindowPortX, but the pixel inside it by x + WindowPortX.
+            int Column = (x - WindowPortX) / 8;
+            int ColumnEnd = x + 8 - ((x - WindowPortX) % 8);
+            const uint8_t *Indices = PPUMapTileRow(PPU, MMU, TMAPLocationStart + ((32 * (WindowRow / 8) + Column) & 0x3FFF), WindowRow % 8);
+            for (; x < End && x < ColumnEnd; x++) {
+                // Draw the window pixel, overriding the background pixel if visible.
+                LinePixels[x] = Colors[Indices[(x + WindowPortX) % 8]];
+                WindowPixels[x] = 1;
+            }
+        }
     }
 
-    uint8_t LowByte;
-    uint8_t HighByte;
+    //Look up the row of every sprite on this line once (Already flipped horizontally if needed) along with its palette.
+    const uint8_t *SpriteIndices[10];
+    uint8_t SpriteColors[10][4];
+    uint8_t SpriteCount = (LCDC & 0x02) ? PPU->CurrentSpriteNum : 0;
 
-    if (MODE == 0) {
-        LowByte = MMU->SystemMemory[TileLocation + (((y + BackgroundPortY) % 8) * 2)];
-        HighByte = MMU->SystemMemory[TileLocation + (((y + BackgroundPortY) % 8) * 2) + 1];
-    }
-    else {
-        LowByte = MMU->SystemMemory[TileLocation + (((PPU->WindowLineCounter) % 8) * 2)];
-        HighByte = MMU->SystemMemory[TileLocation + (((PPU->WindowLineCounter) % 8) * 2) + 1];
-    }
-    
-    //Calculate Color Value based on these bytes
-    uint8_t pixelValue = ((HighByte >> (7 - DisplaypixelX)) & 1) << 1 | ((LowByte >> (7 - DisplaypixelX)) & 1);
+    for (int z = 0; z < SpriteCount; z++) {
+        uint8_t YPos = PPU->SpriteMap[z].YPos;
+        uint8_t TileIndex = PPU->SpriteMap[z].TileIndex;
+        uint8_t Flags = PPU->SpriteMap[z].Flags;
+        uint8_t spriteY = y - (YPos - 16);
+        uint8_t spriteHeight;
 
-    pixelValue = MMU->SystemMemory[0xFF47] >> (pixelValue * 2) & 0x03; //Fix Background Palettes.
+        // Check if the sprite is 8x16 or 8x8
+        if (LCDC & 0x04) {
+            spriteHeight = 16;
+            TileIndex &= 0xFE;
+        }
+        else {
+            spriteHeight = 8;
+        }
 
-    //Update the correct map
-    if (MODE == 1) {
-        PPU->WindowPixel = pixelValue;
-    } 
-    else {
-        PPU->BackgroundPixel = pixelValue;
-    }
-}
+        // Check if Sprite needs to be flipped Vertically.
+        if (Flags & 0x40) {
+            spriteY = spriteHeight - 1 - spriteY;
+        }
 
-//PPU Draw (Searches for Sprites as well) (works by each pixel)
-void PPUDraw(PPU *PPU, MMU *MMU, int x, int y) {
-    //Gameboy Memory Array-
-    //From Dr Mario ROM during Title Screen.
-    uint8_t isWindowPixel = 0;
-    uint8_t currentPixel = 0xFF;
-    uint8_t spriteDrawn = 0;
-    //Run code in loop,.
-    //Update Background Window Data
-    //Using both of these for loops to observe function speed
-    /**/
-    if (MMU->SystemMemory[0xFF40] & 0x01) {
-        //Draw Background.
-        PPUUpdateMap(PPU, MMU, 0, x, y);
-        currentPixel = PPU->BackgroundPixel;
-        PPU->GameBoyDisplay[x][y] = currentPixel;
-    }
-    
-    // Check if the window is enabled
-    if (MMU->SystemMemory[0xFF40] & 0x20) {
-        // Check if the window should be drawn on this scanline
-        if (y >= MMU->SystemMemory[0xFF4A] && x >= (MMU->SystemMemory[0xFF4B] - 7)) {
-            PPUUpdateMap(PPU, MMU, 1, x, y);
-            // Draw the window pixel, overriding the background pixel if visible.
-                currentPixel = PPU->WindowPixel;
-                PPU->GameBoyDisplay[x][y] = currentPixel;
-                isWindowPixel = 1;
+        // Check if Sprite needs to be flipped horizontally.
+        SpriteIndices[z] = PPUTileRow(PPU, MMU, TileIndex * 8 + spriteY, Flags & 0x20);
+
+        //Get the proper Palette Color
+        if (Flags & 0x10) {
+            PPUPaletteColors(MMU->SystemMemory[0xFF49], 8, SpriteColors[z]); // Use OBP1
+        }
+        else {
+            PPUPaletteColors(MMU->SystemMemory[0xFF48], 4, SpriteColors[z]); // Use OBP0
         }
     }
 
-    //Sprite Drawing
-     if (MMU->SystemMemory[0xFF40] & 0x02) {
-        // Check OAM Memory and draw sprites
-        for (int z = 0; z < PPU->CurrentSpriteNum; z++) {
-            //Bytes 0-3
-            uint8_t YPos = PPU->SpriteMap[z].YPos;
+    for (int x = Start; x < End; x++) {
+        uint8_t currentPixel = LinePixels[x];
+        uint8_t isWindowPixel = WindowPixels[x];
+        uint8_t spriteDrawn = 0;
+
+        //Sprite Drawing
+        for (int z = 0; z < SpriteCount; z++) {
             uint8_t XPos = PPU->SpriteMap[z].XPos;
-            uint8_t TileIndex = PPU->SpriteMap[z].TileIndex;
             uint8_t Flags = PPU->SpriteMap[z].Flags;
-            uint8_t spriteY = y - (YPos - 16);
             uint8_t spriteX = x - (XPos - 8);
-            
-            uint8_t spriteHeight;
-            uint8_t pixel;
-            uint8_t PaletteColor;
 
             //Check if SPrite is a duplicate.
-            //if (spriteX < 0 || spriteX >= 8) continue;
             if (spriteX >= 8) continue;
-            
-            // Check if the sprite is 8x16 or 8x8
-            if (MMU->SystemMemory[0xFF40] & 0x04) {
-                spriteHeight = 16;
-                TileIndex &= 0xFE;
-            }
-            else {
-                spriteHeight = 8;
-            }
-                        
-            // Check if Sprite needs to be flipped Vertically.
-            if (Flags & 0x40) {
-                spriteY = spriteHeight - 1 - spriteY;
-            }
-
-            // Check if Sprite needs to be flipped horizontally.
-            if (Flags & 0x20) {
-                spriteX = 7 - spriteX;
-            }
-
-            //Long formula that finds the value of each pixel
-            pixel = (((MMU->SystemMemory[0x8000 + TileIndex * 16 + spriteY * 2 + 1] >> (7 - spriteX)) & 1) << 1) | ((MMU->SystemMemory[0x8000 + TileIndex * 16 + spriteY * 2] >> (7 - spriteX)) & 1);
-                            
-            //Get the proper Palette Color
-            if (Flags & 0x10) {
-                PaletteColor = ((MMU->SystemMemory[0xFF49] >> (pixel * 2)) & 0x03) + 8; // Use OBP1
-            }
-            else {
-                PaletteColor = ((MMU->SystemMemory[0xFF48] >> (pixel * 2)) & 0x03) + 4; // Use OBP0
-            }
 
             //Draw Sprite over if not transparent.
-            if ((pixel != 0)) {
+            uint8_t pixel = SpriteIndices[z][spriteX];
+            if (pixel != 0) {
                 //Check for OAM overlap, SpriteDrawn is just used to account for OAM Priority
                 if ((!spriteDrawn) || (z == 0 || XPos < PPU->SpriteMap[z - 1].XPos)) {
                     //Check if Background or Window is Transparent.
                     if ((Flags & 0x80) == 0 || currentPixel == 0) {
-                        PPU->GameBoyDisplay[x][y] = PaletteColor;
-                        currentPixel = PaletteColor;
+                        currentPixel = SpriteColors[z][pixel];
                         spriteDrawn = 1;
                         isWindowPixel = 0;
                     }
                 }
             }
         }
-    }
 
-    if (isWindowPixel == 1) {
-        PPU->haswindow++;
+        //Pixels nothing was drawn on keep what they had
+        if (currentPixel != 0xFF) {
+            Line[x] = PPU->PaletteRGB[currentPixel];
+        }
+        if (isWindowPixel == 1) {
+            PPU->haswindow++;
+        }
     }
 }
 
-//Render a pixel to the screen, probably update the screen every scanline.
-void PPUPushPixel(PPU *PPU) {
-    uint32_t* pixels;
-    int pitch;
-    
-    if (SDL_LockTexture(texture, NULL, (void**)&pixels, &pitch) == 0) {
-        int pitchPixels = pitch / sizeof(uint32_t);
-        for (int y = 0; y < 144; y++) {
-            for (int x = 0; x < 160; x++) {
-                int palIdx = PPU->GameBoyDisplay[x][y];
-                if (palIdx < 0) palIdx = 0;
-                if (palIdx > 11) palIdx = 11;
-                pixels[y * pitchPixels + x] = DMGPalette[palIdx];
-            }
+//Draws the pixels of the current line the PPU has gone past since the last flush, needed before anything they read changes.
+void PPUFlush(PPU *PPU, MMU *MMU) {
+    if (!PPU->Drawing) {
+        return;
+    }
+    int End = PPU->CurrentX - 80;
+    if (End > 160) {
+        End = 160;
+    }
+    if (End > PPU->DrawnX) {
+        uint8_t LY = MMU->SystemMemory[0xFF44];
+        if (LY < 144) {
+            PPUDraw(PPU, MMU, PPU->DrawnX, End, LY);
         }
-        SDL_UnlockTexture(texture);
+        PPU->DrawnX = End;
+    }
+}
 
-        SDL_RenderClear(renderer);
-        SDL_Rect UpscaledImage = {0, 0, (160 * SCALE), (144 * SCALE)};
-        SDL_RenderCopy(renderer, texture, NULL, &UpscaledImage);
-        SDL_RenderPresent(renderer);
+//Draws whatever is left of the line and hands VRAM back to the CPU.
+static void PPUFinishLine(PPU *PPU, MMU *MMU) {
+    if (PPU->Drawing) {
+        PPUFlush(PPU, MMU);
+        PPU->Drawing = 0;
+        MMUTrapVRAMWrites(MMU, 0);
     }
 }
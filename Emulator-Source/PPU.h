@@ -12,9 +12,9 @@ typedef struct {
 } Sprite;
 
 typedef struct {
-    uint8_t GameBoyDisplay[160][144];
-    uint8_t BackgroundPixel;
-    uint8_t WindowPixel;
+    uint32_t GameBoyDisplay[144][160]; //The frame row by row, as 0xRRGGBB
+    uint32_t *Framebuffer; //Where the pixels get drawn, GameBoyDisplay unless the caller handed over its own buffer
+    uint32_t PaletteRGB[12]; //DMGPalette at PPUInit, the colour for each of the 12 palette entries
     uint8_t NumSpritePixels; 
 
     Sprite SpriteMap[10]; //Max amount of sprites per scanline
@@ -27,17 +27,33 @@ typedef struct {
     uint8_t haswindow;
     uint8_t ScanlineDelay;
 
+    uint8_t FrameReady; //Set at the start of VBlank, cleared by whoever consumes the frame.
+    int IdleTicks; //Ticks left in the current stretch where PPUTick would only move X along
+
+    uint8_t Drawing; //Set while the current line still has pixels for PPUFlush to draw
+    uint8_t SkipDrawing; //Set while fast forwarding, the lines keep their timing and interrupts but no pixels get drawn
+    uint8_t SkipFrame; //SkipDrawing as of the start of the current frame, so a frame is either drawn whole or not at all
+    int DrawnX; //Pixels of the current line drawn so far
+
+    //Tile Cache, the 384 tiles in VRAM decoded to one byte per pixel (0-3), indexed by Tile * 8 + Row. Refreshed from MMU->TileDirty.
+    uint8_t TileRows[384 * 8][8];
+    uint8_t FlippedTileRows[384 * 8][8];
+
 } PPU;
 
 
 
 
 void PPUInit(PPU *PPU, MMU *MMU);
+void PPUSelectDecoder(void); //Picks the fastest tile row decoder that matches the scalar one exactly (Done by the first PPUInit).
+const char *PPUDecoder(void); //Name of the selected tile row decoder.
 
-void PPUUpdateMap(PPU *PPU, MMU *MMU, uint8_t MODE, uint8_t x, uint8_t y);
 void PPUOAMSearch(PPU *PPU, MMU *MMU, uint8_t LY);
 
 void PPUTick(PPU *PPU, MMU *MMU);
-void PPUDraw(PPU *PPU, MMU *MMU, int x, int y);
-void PPUPushPixel(PPU *PPU);
+void PPUAdvance(PPU *PPU, MMU *MMU, int Ticks); //Runs Ticks worth of PPUTick, skipping over dots where nothing happens.
+int PPUIdleRun(PPU *PPU, MMU *MMU);
+int PPUNextEvent(PPU *PPU, MMU *MMU); //Ticks until the next tick that is not skipped over, for the scheduler.
+void PPUDraw(PPU *PPU, MMU *MMU, int Start, int End, int y); //Draws pixels Start to End - 1 of scanline y.
+void PPUFlush(PPU *PPU, MMU *MMU); //Draws the pixels the PPU has passed on the current line, call before changing anything they depend on.
 #endif // PPU_H
\ No newline at end of file
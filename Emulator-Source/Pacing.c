@@ -0,0 +1,63 @@
+#include "Pacing.h"
+
+#ifndef HEADLESS
+void PacingInit(Pacing *Pacing, int Speed) {
+    Pacing->Frequency = SDL_GetPerformanceFrequency();
+    Pacing->Next = SDL_GetPerformanceCounter();
+    Pacing->Remainder = 0;
+    Pacing->CurrentSpeed = 0; //Picked up (and the clock restarted) by the first PacingWait
+    PacingSetSpeed(Pacing, Speed);
+    SDL_AtomicSet(&Pacing->Turbo, 0);
+}
+
+void PacingSetSpeed(Pacing *Pacing, int Speed) {
+    SDL_AtomicSet(&Pacing->Speed, (Speed < 1) ? 1 : Speed);
+}
+
+void PacingSetTurbo(Pacing *Pacing, int Turbo) {
+    SDL_AtomicSet(&Pacing->Turbo, Turbo);
+}
+
+void PacingWait(Pacing *Pacing, uint64_t Ticks) {
+    uint64_t Now = SDL_GetPerformanceCounter();
+
+    //Turbo keeps the clock pinned to now, so dropping out of it doesn't leave a backlog to race through.
+    if (SDL_AtomicGet(&Pacing->Turbo)) {
+        Pacing->Next = Now;
+        Pacing->Remainder = 0;
+        return;
+    }
+
+    //A new speed counts from the end of this frame instead of rescaling the time that's already been run.
+    int Speed = SDL_AtomicGet(&Pacing->Speed);
+    if (Speed != Pacing->CurrentSpeed) {
+        Pacing->CurrentSpeed = Speed;
+        Pacing->Next = Now;
+        Pacing->Remainder = 0;
+    }
+
+    //Ticks * Frequency / (PACING_CLOCK * Speed / 100), with the remainder carried over to the next frame
+    uint64_t Scale = (uint64_t)PACING_CLOCK * Speed;
+    uint64_t Elapsed = Ticks * Pacing->Frequency * 100 + Pacing->Remainder;
+    Pacing->Next += Elapsed / Scale;
+    Pacing->Remainder = Elapsed % Scale;
+
+    if (Now >= Pacing->Next) {
+        //Running behind (Host too slow or the window got dragged), drop the debt once it's more than a few frames rather than fast forward through it.
+        if (Now - Pacing->Next > Pacing->Frequency * 70224 * PACING_MAX_LAG / PACING_CLOCK) {
+            Pacing->Next = Now;
+            Pacing->Remainder = 0;
+        }
+        return;
+    }
+
+    //Sleep off most of the wait, then spin the last couple of milliseconds so the frame lands on time.
+    while (Now < Pacing->Next) {
+        uint64_t Remaining = (Pacing->Next - Now) * 1000 / Pacing->Frequency;
+        if (Remaining > PACING_SPIN_MS) {
+            SDL_Delay((Uint32)(Remaining - PACING_SPIN_MS));
+        }
+        Now = SDL_GetPerformanceCounter();
+    }
+}
+#endif
@@ -0,0 +1,36 @@
+#ifndef PACING_H
+#define PACING_H
+
+#ifndef HEADLESS
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+/*
+    Pacing (Real-time speed control)
+    The Game Boy runs 4194304 ticks a second, so a 70224 tick frame lasts 16.74 ms (59.73 Hz) no matter what the monitor refreshes at.
+    After every frame the emulation thread tells the pacer how many ticks it ran, and the pacer holds it until the high resolution clock
+    catches up with that many ticks of real time. It sleeps while the deadline is far off and spins through the last stretch, since a sleep can
+    overshoot by a good fraction of a millisecond (Much more on Windows).
+    Speed is a percentage of the real hardware (Set from any thread), turbo drops the wait entirely.
+*/
+#define PACING_CLOCK 4194304 //Game Boy ticks per second
+#define PACING_SPIN_MS 2 //How close to the deadline it stops sleeping and starts spinning
+#define PACING_MAX_LAG 5 //Frames it can fall behind before it gives up on catching up
+
+typedef struct {
+    uint64_t Frequency; //Performance counter ticks per second
+    uint64_t Next; //Counter value the emulated time so far is due at
+    uint64_t Remainder; //Leftover fraction of a counter tick (Out of PACING_CLOCK * Speed), so long runs don't drift
+
+    SDL_atomic_t Speed; //Percent of the Game Boy's speed (100 = 59.73 FPS)
+    SDL_atomic_t Turbo; //Runs as fast as the host allows while set
+    int CurrentSpeed; //Speed the deadline is being counted at
+} Pacing;
+
+void PacingInit(Pacing *Pacing, int Speed); //Starts the clock from now.
+void PacingSetSpeed(Pacing *Pacing, int Speed); //Takes effect from the next frame, values under 1 are clamped.
+void PacingSetTurbo(Pacing *Pacing, int Turbo);
+void PacingWait(Pacing *Pacing, uint64_t Ticks); //Emulation thread, call after running Ticks worth of emulation. Returns once they are due.
+
+#endif
+#endif // PACING_H
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Rewind.h"
+#include "State.h"
+
+void RewindInit(Rewind *Rewind, DMG *Gameboy, size_t Bytes, int Interval) {
+    memset(Rewind, 0, sizeof(*Rewind));
+    Rewind->Gameboy = Gameboy;
+    Rewind->Interval = (Interval > 0) ? Interval : 1;
+    if (Bytes == 0) {
+        return; //Rewinding is off, Ring stays NULL
+    }
+    Rewind->Capacity = Bytes;
+    Rewind->Ring = (uint8_t *)malloc(Bytes);
+    Rewind->Current = (uint8_t *)malloc(StateRawSize(Gameboy));
+    Rewind->Scratch = (uint8_t *)malloc(StateRawSize(Gameboy));
+    Rewind->Packed = (uint8_t *)malloc(StateMaxSize(Gameboy));
+
+    //Everything after this gets stored against the machine as it starts out.
+    StateCapture(Gameboy, Rewind->Current);
+}
+
+void RewindFree(Rewind *Rewind) {
+    free(Rewind->Ring);
+    free(Rewind->Current);
+    free(Rewind->Scratch);
+    free(Rewind->Packed);
+}
+
+static void RewindDropOldest(Rewind *Rewind) {
+    Rewind->Oldest = (Rewind->Oldest + 1) % REWIND_MAX_SNAPSHOTS;
+    Rewind->Count--;
+}
+
+//Puts a delta at the head of the ring, dropping the oldest deltas in the way. The ring is either one run of deltas or two with the
+//older run after Head, so whatever is in the way is always the oldest.
+static void RewindStore(Rewind *Rewind, const uint8_t *Delta, size_t Size) {
+    if (Size > Rewind->Capacity) {
+        Rewind->Count = 0; //Can't keep it, and nothing older can be reached without it
+        return;
+    }
+    if (Rewind->Count == REWIND_MAX_SNAPSHOTS) {
+        RewindDropOldest(Rewind);
+    }
+    if (Rewind->Head + Size > Rewind->Capacity) {
+        //Doesn't fit before the end, everything still out there is older than what's at the start.
+        while (Rewind->Count > 0 && Rewind->Offsets[Rewind->Oldest] >= Rewind->Head) {
+            RewindDropOldest(Rewind);
+        }
+        Rewind->Head = 0;
+    }
+    while (Rewind->Count > 0 && Rewind->Offsets[Rewind->Oldest] >= Rewind->Head && Rewind->Offsets[Rewind->Oldest] < Rewind->Head + Size) {
+        RewindDropOldest(Rewind);
+    }
+
+    int Newest = (Rewind->Oldest + Rewind->Count) % REWIND_MAX_SNAPSHOTS;
+    memcpy(Rewind->Ring + Rewind->Head, Delta, Size);
+    Rewind->Offsets[Newest] = (uint32_t)Rewind->Head;
+    Rewind->Sizes[Newest] = (uint32_t)Size;
+    Rewind->Count++;
+    Rewind->Head += Size;
+}
+
+void RewindFrame(Rewind *Rewind) {
+    if (Rewind->Ring == NULL || ++Rewind->FramesSince < Rewind->Interval) {
+        return;
+    }
+
+    //The delta against the last snapshot takes this one back to it, and this one becomes the newest.
+    size_t Size = StateSave(Rewind->Gameboy, Rewind->Scratch, Rewind->Current, Rewind->Packed);
+    RewindStore(Rewind, Rewind->Packed, Size);
+
+    uint8_t *Swap = Rewind->Current;
+    Rewind->Current = Rewind->Scratch;
+    Rewind->Scratch = Swap;
+    Rewind->FramesSince = 0;
+}
+
+int RewindStep(Rewind *Rewind) {
+    if (Rewind->Ring == NULL) {
+        return 0;
+    }
+    //Frames run since the newest snapshot go first.
+    if (Rewind->FramesSince > 0) {
+        int Frames = Rewind->FramesSince;
+        StateRestore(Rewind->Gameboy, Rewind->Current);
+        Rewind->FramesSince = 0;
+        return Frames;
+    }
+    if (Rewind->Count == 0) {
+        return 0;
+    }
+
+    int Newest = (Rewind->Oldest + Rewind->Count - 1) % REWIND_MAX_SNAPSHOTS;
+    if (StateLoad(Rewind->Gameboy, Rewind->Scratch, Rewind->Current, Rewind->Ring + Rewind->Offsets[Newest], Rewind->Sizes[Newest]) != 0) {
+        Rewind->Count = 0;
+        return 0;
+    }
+    uint8_t *Swap = Rewind->Current;
+    Rewind->Current = Rewind->Scratch;
+    Rewind->Scratch = Swap;
+    Rewind->Count--;
+    Rewind->Head = Rewind->Offsets[Newest]; //Its space is free again
+    return Rewind->Interval;
+}
+
+double RewindSeconds(Rewind *Rewind) {
+    return (double)(Rewind->Count * Rewind->Interval + Rewind->FramesSince) / 59.73;
+}
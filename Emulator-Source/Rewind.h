@@ -0,0 +1,43 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "DMG.h"
+
+/*
+    Rewind (Snapshot history)
+    Every Interval frames the machine is captured as a save state (State.h). Only the newest snapshot is kept whole, every older one is stored as
+    the compressed XOR of it and the snapshot after it, so it mostly holds the bytes of memory (and the registers) that changed in between.
+    XOR works both ways, so undoing the newest delta on the newest snapshot gives back the one before it, and rewinding walks back one delta at a time.
+
+    The deltas live one after another in a fixed size byte ring. Once it's full the oldest ones are dropped to make room, which costs nothing since
+    nothing is ever built forwards from them.
+*/
+#define REWIND_MAX_SNAPSHOTS (1 << 16) //Most deltas kept no matter how small they are (18 minutes with an interval of 1)
+
+typedef struct {
+    DMG *Gameboy;
+    uint8_t *Ring; //Compressed deltas, newest at Offsets[Newest]
+    size_t Capacity;
+    size_t Head; //Where the next delta goes
+    uint32_t Offsets[REWIND_MAX_SNAPSHOTS];
+    uint32_t Sizes[REWIND_MAX_SNAPSHOTS];
+    int Oldest; //Index of the oldest delta in Offsets/Sizes
+    int Count; //Deltas in the ring
+
+    uint8_t *Current; //Raw state of the newest snapshot
+    uint8_t *Scratch; //Raw state being captured or restored
+    uint8_t *Packed; //Largest delta StateSave can write
+    int Interval; //Frames between snapshots
+    int FramesSince; //Frames run since the newest snapshot
+} Rewind;
+
+//Allocates Bytes of ring for the given DMG (after DMGInit), taking a snapshot every Interval frames. Bytes of 0 turns rewinding off.
+void RewindInit(Rewind *Rewind, DMG *Gameboy, size_t Bytes, int Interval);
+void RewindFree(Rewind *Rewind);
+void RewindFrame(Rewind *Rewind); //Call after every frame that was run, takes a snapshot once Interval frames have gone by.
+int RewindStep(Rewind *Rewind); //Puts the machine back one snapshot, returns how many frames that went back (0 once there's nothing older left).
+double RewindSeconds(Rewind *Rewind); //How far back the history currently goes.
+
+#endif // REWIND_H
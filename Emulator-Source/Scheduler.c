@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Scheduler.h"
+
+void SchedulerInit(Scheduler *Scheduler) {
+    Scheduler->Cycle = 0;
+    Scheduler->HeapSize = 0;
+    for (int i = 0; i < SCHED_COUNT; i++) {
+        Scheduler->SyncedTo[i] = 0;
+        Scheduler->Position[i] = -1;
+    }
+}
+
+//Swaps two heap entries and keeps the Position lookup in sync.
+static void SchedulerSwap(Scheduler *Scheduler, int a, int b) {
+    SchedulerEvent Temp = Scheduler->Heap[a];
+    Scheduler->Heap[a] = Scheduler->Heap[b];
+    Scheduler->Heap[b] = Temp;
+    Scheduler->Position[Scheduler->Heap[a].Type] = a;
+    Scheduler->Position[Scheduler->Heap[b].Type] = b;
+}
+
+static void SchedulerSiftUp(Scheduler *Scheduler, int i) {
+    while (i > 0) {
+        int Parent = (i - 1) / 2;
+        if (Scheduler->Heap[Parent].Time <= Scheduler->Heap[i].Time) {
+            break;
+        }
+        SchedulerSwap(Scheduler, i, Parent);
+        i = Parent;
+    }
+}
+
+static void SchedulerSiftDown(Scheduler *Scheduler, int i) {
+    while (1) {
+        int Smallest = i;
+        int Left = i * 2 + 1;
+        int Right = i * 2 + 2;
+        if (Left < Scheduler->HeapSize && Scheduler->Heap[Left].Time < Scheduler->Heap[Smallest].Time) {
+            Smallest = Left;
+        }
+        if (Right < Scheduler->HeapSize && Scheduler->Heap[Right].Time < Scheduler->Heap[Smallest].Time) {
+            Smallest = Right;
+        }
+        if (Smallest == i) {
+            break;
+        }
+        SchedulerSwap(Scheduler, i, Smallest);
+        i = Smallest;
+    }
+}
+
+void SchedulerSet(Scheduler *Scheduler, int Type, uint64_t Time) {
+    int i = Scheduler->Position[Type];
+    if (i < 0) {
+        i = Scheduler->HeapSize++;
+        Scheduler->Heap[i].Type = Type;
+        Scheduler->Position[Type] = i;
+    }
+    Scheduler->Heap[i].Time = Time;
+    SchedulerSiftUp(Scheduler, i);
+    SchedulerSiftDown(Scheduler, Scheduler->Position[Type]);
+}
+
+void SchedulerRemove(Scheduler *Scheduler, int Type) {
+    int i = Scheduler->Position[Type];
+    if (i < 0) {
+        return;
+    }
+    Scheduler->HeapSize--;
+    if (i != Scheduler->HeapSize) {
+        //Move the last event into the hole and put it back in order.
+        int Moved = Scheduler->Heap[Scheduler->HeapSize].Type;
+        SchedulerSwap(Scheduler, i, Scheduler->HeapSize);
+        SchedulerSiftUp(Scheduler, i);
+        SchedulerSiftDown(Scheduler, Scheduler->Position[Moved]);
+    }
+    Scheduler->Position[Type] = -1;
+}
+
+uint64_t SchedulerNext(Scheduler *Scheduler) {
+    if (Scheduler->HeapSize == 0) {
+        return UINT64_MAX;
+    }
+    return Scheduler->Heap[0].Time;
+}
+
+int SchedulerPop(Scheduler *Scheduler) {
+    int Type = Scheduler->Heap[0].Type;
+    SchedulerRemove(Scheduler, Type);
+    return Type;
+}
@@ -0,0 +1,39 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+/*
+    Event Scheduler
+    Every component only changes something the CPU can see on a known tick (PPU mode/scanline changes, DIV/TIMA increments, frame sequencer steps).
+    Each component keeps one event in a min heap keyed on the absolute tick count, and only gets run once that tick has been reached.
+*/
+enum {
+    SCHED_PPU,
+    SCHED_TIMER,
+    SCHED_APU,
+    SCHED_DEADLINE, //Not a component, marks where DMGRunFrame has to stop.
+    SCHED_COUNT
+};
+
+typedef struct {
+    uint64_t Time; //Absolute tick the event is due on
+    int Type;
+} SchedulerEvent;
+
+typedef struct {
+    uint64_t Cycle; //Absolute tick count at the start of the current instruction
+    uint64_t SyncedTo[SCHED_COUNT]; //Tick each component has been run up to
+
+    SchedulerEvent Heap[SCHED_COUNT];
+    int HeapSize;
+    int Position[SCHED_COUNT]; //Where each event type sits in the heap (-1 if not scheduled)
+} Scheduler;
+
+void SchedulerInit(Scheduler *Scheduler);
+void SchedulerSet(Scheduler *Scheduler, int Type, uint64_t Time); //Adds the event, or moves it if it is already scheduled.
+void SchedulerRemove(Scheduler *Scheduler, int Type);
+uint64_t SchedulerNext(Scheduler *Scheduler); //Time of the earliest event (UINT64_MAX if there is none).
+int SchedulerPop(Scheduler *Scheduler); //Removes the earliest event and returns its type.
+
+#endif // SCHEDULER_H
@@ -0,0 +1,395 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "State.h"
+
+extern int RAMSize;
+
+#define STATE_HASH_BITS 12 //Compressor hash table size (4096 entries)
+#define STATE_MIN_MATCH 4
+#define STATE_MAX_OFFSET 0xFFFF
+#define STATE_LAST_LITERALS 8 //The end of the input is always left as literals, so matches never run up to it
+#define STATE_COLOUR_HASH(Colour) (((Colour) * 0x9E3779B1u) >> 24)
+
+//Copies one piece of the state between the machine and Raw, Saving picks the direction. Raw can be NULL to only count the size.
+static void StateCopy(uint8_t *Raw, size_t *Offset, void *Live, size_t Size, int Saving) {
+    if (Raw != NULL) {
+        if (Saving) {
+            memcpy(Raw + *Offset, Live, Size);
+        }
+        else {
+            memcpy(Live, Raw + *Offset, Size);
+        }
+    }
+    *Offset += Size;
+}
+
+/*The frame is stored as the palette entry (0-11) of each pixel, two to a byte, rather than as 0xRRGGBB.
+  Every pixel the PPU draws is one of PaletteRGB's colours, and they come back out in whatever colours the palette has on load. */
+static void StateFrame(uint8_t *Raw, size_t *Offset, PPU *PPU, int Saving) {
+    const size_t Size = 160 * 144 / 2;
+    if (Raw != NULL) {
+        uint8_t *Packed = Raw + *Offset;
+        uint32_t *Pixels = PPU->Framebuffer;
+        if (Saving) {
+            //Colours are looked up in a small hash table, a pair it gets wrong (Two colours in one slot) falls back to a search. Any entry with the right colour will do.
+            const uint32_t *Palette = PPU->PaletteRGB;
+            uint8_t Table[256];
+            memset(Table, 0, sizeof(Table));
+            for (int Entry = 11; Entry >= 0; Entry--) {
+                Table[STATE_COLOUR_HASH(Palette[Entry])] = (uint8_t)Entry;
+            }
+            for (int i = 0; i < 160 * 144; i += 2) {
+                uint8_t Low = Table[STATE_COLOUR_HASH(Pixels[i])];
+                uint8_t High = Table[STATE_COLOUR_HASH(Pixels[i + 1])];
+                if (Palette[Low] != Pixels[i] || Palette[High] != Pixels[i + 1]) {
+                    for (uint8_t Entry = 0; Entry < 12; Entry++) {
+                        Low = (Palette[Entry] == Pixels[i]) ? Entry : Low;
+                        High = (Palette[Entry] == Pixels[i + 1]) ? Entry : High;
+                    }
+                }
+                Packed[i >> 1] = (uint8_t)(Low | (High << 4));
+            }
+        }
+        else {
+            for (int i = 0; i < 160 * 144; i++) {
+                Pixels[i] = PPU->PaletteRGB[(Packed[i >> 1] >> ((i & 1) * 4)) & 0x0F];
+            }
+        }
+    }
+    *Offset += Size;
+}
+
+/*Walks every piece of the state in the same order for saving and loading, so the two can't get out of step. Returns the raw size.
+  Host side fields (Framebuffer pointer, page table, hooks, tile cache, palette, SkipDrawing, Muted, the blip buffer) are left out on purpose. */
+static size_t StateWalk(DMG *DMG, uint8_t *Raw, int Saving) {
+    CPU *CPU = &DMG->DMG_CPU;
+    PPU *PPU = &DMG->DMG_PPU;
+    MMU *MMU = &DMG->DMG_MMU;
+    APU *APU = &DMG->DMG_APU;
+    size_t Offset = 0;
+
+#define STATE_PART(Pointer, Size) StateCopy(Raw, &Offset, (void *)(Pointer), (Size), Saving)
+#define STATE_FIELD(Field) STATE_PART(&(Field), sizeof(Field))
+
+    //CPU (Plain registers and flags)
+    STATE_FIELD(*CPU);
+
+    //PPU, the frame so far comes out of wherever it is being drawn
+    StateFrame(Raw, &Offset, PPU, Saving);
+    STATE_FIELD(PPU->NumSpritePixels);
+    STATE_FIELD(PPU->SpriteMap);
+    STATE_FIELD(PPU->CurrentSpriteNum);
+    STATE_FIELD(PPU->CurrentX);
+    STATE_FIELD(PPU->WindowLineCounter);
+    STATE_FIELD(PPU->Mode3Length);
+    STATE_FIELD(PPU->haswindow);
+    STATE_FIELD(PPU->ScanlineDelay);
+    STATE_FIELD(PPU->FrameReady);
+    STATE_FIELD(PPU->IdleTicks);
+    STATE_FIELD(PPU->Drawing);
+    STATE_FIELD(PPU->SkipFrame);
+    STATE_FIELD(PPU->DrawnX);
+
+    //MMU, everything below 0x8000 is ROM (Read through the page table, never out of SystemMemory)
+    STATE_PART(MMU->SystemMemory + 0x8000, 0x8000);
+    STATE_FIELD(MMU->CurrentROMBank);
+    STATE_FIELD(MMU->CurrentRAMBank);
+    STATE_FIELD(MMU->RTCMode);
+    STATE_FIELD(MMU->DMASource);
+    STATE_FIELD(MMU->DMADestination);
+    STATE_FIELD(MMU->DMACount);
+    STATE_FIELD(MMU->Ticks);
+    STATE_FIELD(MMU->PrevInstruct);
+    STATE_FIELD(MMU->GameBoyController);
+    STATE_FIELD(MMU->JoypadButtons);
+    STATE_FIELD(MMU->JoypadDirections);
+    STATE_FIELD(MMU->VRAMTrap);
+    STATE_PART(MMU->RAMFile, RAMSize);
+
+    //Timer
+    STATE_FIELD(DMG->DMG_Timer);
+
+    //APU channels and frame sequencer
+    STATE_FIELD(APU->PulseWithSweep);
+    STATE_FIELD(APU->Pulse);
+    STATE_FIELD(APU->Wave);
+    STATE_FIELD(APU->Noise);
+    STATE_FIELD(APU->NR50);
+    STATE_FIELD(APU->NR51);
+    STATE_FIELD(APU->NR52);
+    STATE_FIELD(APU->FrameSequencerStep);
+    STATE_FIELD(APU->FrameSequencerCounter);
+    STATE_FIELD(APU->Ticks);
+
+    //Scheduler (Absolute tick counts and pending events)
+    STATE_FIELD(DMG->DMG_Scheduler);
+
+#undef STATE_FIELD
+#undef STATE_PART
+    return Offset;
+}
+
+size_t StateRawSize(DMG *DMG) {
+    return StateWalk(DMG, NULL, 1);
+}
+
+//Worst case for the compressor (Nothing matches) is one extra length byte per 255 literals plus the token.
+static size_t StateBound(size_t Size) {
+    return Size + Size / 255 + 16;
+}
+
+size_t StateMaxSize(DMG *DMG) {
+    return sizeof(StateHeader) + StateBound(StateRawSize(DMG));
+}
+
+void StateCapture(DMG *DMG, uint8_t *Raw) {
+    StateWalk(DMG, Raw, 1);
+}
+
+void StateRestore(DMG *DMG, const uint8_t *Raw) {
+    uint8_t LOG = DMG->DMG_CPU.LOG;
+
+    StateWalk(DMG, (uint8_t *)Raw, 0);
+
+    DMG->DMG_CPU.LOG = LOG;
+    MMUMapPages(&DMG->DMG_MMU); //Banks, RTC and VRAM trap as they were in the state
+    memset(DMG->DMG_MMU.TileDirty, 1, sizeof(DMG->DMG_MMU.TileDirty)); //The tile cache isn't stored, decode every tile again
+    APUUpdateLevels(&DMG->DMG_APU, DMG->DMG_APU.BlipTime); //Step the audio output over to the restored channels
+}
+
+//Compression (LZ4 style: a token with 4 bit literal and match lengths, the literals, then a 16 bit offset back to the match)
+static inline uint32_t StateRead32(const uint8_t *p) {
+    uint32_t Value;
+    memcpy(&Value, p, 4);
+    return Value;
+}
+
+static uint8_t *StateWriteLength(uint8_t *Out, size_t Length) {
+    while (Length >= 255) {
+        *Out++ = 255;
+        Length -= 255;
+    }
+    *Out++ = (uint8_t)Length;
+    return Out;
+}
+
+static uint8_t *StateWriteSequence(uint8_t *Out, const uint8_t *Literals, size_t LiteralCount, size_t Offset, size_t MatchLength) {
+    uint8_t *Token = Out++;
+    size_t MatchCode = (MatchLength > 0) ? MatchLength - STATE_MIN_MATCH : 0;
+
+    *Token = (uint8_t)(((LiteralCount < 15) ? LiteralCount : 15) << 4);
+    if (LiteralCount >= 15) {
+        Out = StateWriteLength(Out, LiteralCount - 15);
+    }
+    memcpy(Out, Literals, LiteralCount);
+    Out += LiteralCount;
+
+    if (MatchLength > 0) {
+        *Out++ = (uint8_t)(Offset & 0xFF);
+        *Out++ = (uint8_t)(Offset >> 8);
+        *Token |= (uint8_t)((MatchCode < 15) ? MatchCode : 15);
+        if (MatchCode >= 15) {
+            Out = StateWriteLength(Out, MatchCode - 15);
+        }
+    }
+    return Out;
+}
+
+static size_t StateCompress(const uint8_t *In, size_t Size, uint8_t *Out) {
+    uint32_t Table[1 << STATE_HASH_BITS]; //Last position each hash of 4 bytes was seen at
+    uint8_t *Start = Out;
+    size_t Anchor = 0;
+    size_t i = 0;
+
+    memset(Table, 0, sizeof(Table));
+    while (Size > STATE_LAST_LITERALS + STATE_MIN_MATCH && i < Size - STATE_LAST_LITERALS - STATE_MIN_MATCH) {
+        uint32_t Sequence = StateRead32(In + i);
+        uint32_t Hash = (Sequence * 2654435761u) >> (32 - STATE_HASH_BITS);
+        size_t Candidate = Table[Hash];
+        Table[Hash] = (uint32_t)i;
+
+        if (Candidate >= i || i - Candidate > STATE_MAX_OFFSET || StateRead32(In + Candidate) != Sequence) {
+            i++;
+            continue;
+        }
+
+        //Extend the match 8 bytes at a time, then byte by byte.
+        size_t Length = STATE_MIN_MATCH;
+        size_t Limit = Size - STATE_LAST_LITERALS - i;
+        while (Length + 8 <= Limit) {
+            uint64_t a, b;
+            memcpy(&a, In + Candidate + Length, 8);
+            memcpy(&b, In + i + Length, 8);
+            if (a != b) {
+                break;
+            }
+            Length += 8;
+        }
+        while (Length < Limit && In[Candidate + Length] == In[i + Length]) {
+            Length++;
+        }
+
+        Out = StateWriteSequence(Out, In + Anchor, i - Anchor, i - Candidate, Length);
+        i += Length;
+        Anchor = i;
+    }
+    Out = StateWriteSequence(Out, In + Anchor, Size - Anchor, 0, 0);
+    return (size_t)(Out - Start);
+}
+
+//Returns -1 if the data runs past either end, or doesn't fill Out exactly.
+static int StateDecompress(const uint8_t *In, size_t InSize, uint8_t *Out, size_t OutSize) {
+    const uint8_t *InEnd = In + InSize;
+    size_t o = 0;
+
+    while (In < InEnd) {
+        uint8_t Token = *In++;
+
+        size_t LiteralCount = Token >> 4;
+        if (LiteralCount == 15) {
+            uint8_t Byte;
+            do {
+                if (In >= InEnd) return -1;
+                Byte = *In++;
+                LiteralCount += Byte;
+            } while (Byte == 255);
+        }
+        if (LiteralCount > (size_t)(InEnd - In) || LiteralCount > OutSize - o) {
+            return -1;
+        }
+        memcpy(Out + o, In, LiteralCount);
+        In += LiteralCount;
+        o += LiteralCount;
+
+        if (In == InEnd) {
+            break; //The last sequence has no match
+        }
+        if (InEnd - In < 2) {
+            return -1;
+        }
+        size_t Offset = In[0] | (In[1] << 8);
+        In += 2;
+        size_t Length = (Token & 0x0F);
+        if (Length == 15) {
+            uint8_t Byte;
+            do {
+                if (In >= InEnd) return -1;
+                Byte = *In++;
+                Length += Byte;
+            } while (Byte == 255);
+        }
+        Length += STATE_MIN_MATCH;
+        if (Offset == 0 || Offset > o || Length > OutSize - o) {
+            return -1;
+        }
+        //Byte by byte, the match may overlap what it is writing (Runs)
+        for (size_t k = 0; k < Length; k++) {
+            Out[o + k] = Out[o - Offset + k];
+        }
+        o += Length;
+    }
+    return (o == OutSize) ? 0 : -1;
+}
+
+static void StateXOR(uint8_t *Raw, const uint8_t *Base, size_t Size) {
+    size_t i = 0;
+    for (; i + 8 <= Size; i += 8) {
+        uint64_t a, b;
+        memcpy(&a, Raw + i, 8);
+        memcpy(&b, Base + i, 8);
+        a ^= b;
+        memcpy(Raw + i, &a, 8);
+    }
+    for (; i < Size; i++) {
+        Raw[i] ^= Base[i];
+    }
+}
+
+static void StateFillHeader(DMG *DMG, StateHeader *Header) {
+    memset(Header, 0, sizeof(StateHeader));
+    memcpy(Header->Magic, STATE_MAGIC, 8);
+    Header->Version = STATE_VERSION;
+    Header->RawSize = (uint32_t)StateRawSize(DMG);
+    memcpy(Header->Title, DMG->DMG_MMU.ROMFile + 0x134, 16);
+    Header->ROMChecksum = (uint16_t)((DMG->DMG_MMU.ROMFile[0x14E] << 8) | DMG->DMG_MMU.ROMFile[0x14F]);
+}
+
+size_t StateSave(DMG *DMG, uint8_t *Raw, const uint8_t *Base, uint8_t *Out) {
+    StateHeader Header;
+    StateFillHeader(DMG, &Header);
+    Header.Delta = (Base != NULL);
+
+    StateCapture(DMG, Raw);
+    if (Base != NULL) {
+        StateXOR(Raw, Base, Header.RawSize);
+    }
+    Header.PackedSize = (uint32_t)StateCompress(Raw, Header.RawSize, Out + sizeof(StateHeader));
+    if (Base != NULL) {
+        StateXOR(Raw, Base, Header.RawSize); //Raw goes back to the plain state, so it can be the next save's base
+    }
+
+    memcpy(Out, &Header, sizeof(StateHeader));
+    return sizeof(StateHeader) + Header.PackedSize;
+}
+
+int StateLoad(DMG *DMG, uint8_t *Raw, const uint8_t *Base, const uint8_t *In, size_t Size) {
+    StateHeader Expected;
+    StateHeader Header;
+    StateFillHeader(DMG, &Expected);
+
+    if (Size < sizeof(StateHeader)) {
+        return -1;
+    }
+    memcpy(&Header, In, sizeof(StateHeader));
+    if (memcmp(Header.Magic, Expected.Magic, 8) != 0 || Header.Version != Expected.Version || Header.RawSize != Expected.RawSize) {
+        return -1; //Another build (or another cartridge RAM size)
+    }
+    if (memcmp(Header.Title, Expected.Title, 16) != 0 || Header.ROMChecksum != Expected.ROMChecksum) {
+        return -1; //Another game
+    }
+    if (Header.Delta != (Base != NULL) || Header.PackedSize > Size - sizeof(StateHeader)) {
+        return -1;
+    }
+    if (StateDecompress(In + sizeof(StateHeader), Header.PackedSize, Raw, Header.RawSize) != 0) {
+        return -1;
+    }
+    if (Base != NULL) {
+        StateXOR(Raw, Base, Header.RawSize);
+    }
+    StateRestore(DMG, Raw);
+    return 0;
+}
+
+int StateSaveFile(DMG *DMG, const char *Path) {
+    uint8_t *Raw = (uint8_t *)malloc(StateRawSize(DMG));
+    uint8_t *Packed = (uint8_t *)malloc(StateMaxSize(DMG));
+    size_t Size = StateSave(DMG, Raw, NULL, Packed);
+
+    int Result = -1;
+    FILE *File = fopen(Path, "wb");
+    if (File != NULL) {
+        Result = (fwrite(Packed, 1, Size, File) == Size) ? 0 : -1;
+        fclose(File);
+    }
+    free(Raw);
+    free(Packed);
+    return Result;
+}
+
+int StateLoadFile(DMG *DMG, const char *Path) {
+    FILE *File = fopen(Path, "rb");
+    if (File == NULL) {
+        return -1;
+    }
+    size_t Capacity = StateMaxSize(DMG);
+    uint8_t *Raw = (uint8_t *)malloc(StateRawSize(DMG));
+    uint8_t *Packed = (uint8_t *)malloc(Capacity);
+    size_t Size = fread(Packed, 1, Capacity, File);
+    fclose(File);
+
+    int Result = StateLoad(DMG, Raw, NULL, Packed, Size);
+    free(Raw);
+    free(Packed);
+    return Result;
+}
@@ -0,0 +1,46 @@
+#ifndef STATE_H
+#define STATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "DMG.h"
+
+/*
+    Save States
+    A state is everything the running game can see or will see later: the CPU, the PPU's position and current frame, the Timer, the APU channels,
+    the scheduler, WRAM/VRAM/OAM/I/O/HRAM (0x8000-0xFFFF) and cartridge RAM with the selected banks and DMA progress.
+    Nothing that comes from the ROM is stored (the ROM itself, bank counts, MBC type), only its title and checksum so a state can't be loaded into
+    a different game. Host side things (pointers, the page table, the tile cache, palette, fast forward and audio output) are left as they are on load.
+
+    The raw state is stored as a delta against a base state (XOR, so whatever didn't change turns into zeros) and compressed with a small LZ77
+    compressor in the style of LZ4. Without a base it is compressed as is, which is what files use since they have to load into a fresh emulator.
+    The layout follows the structs of the build that made it, so a state only loads into a build with the same STATE_VERSION and raw size.
+*/
+#define STATE_MAGIC "EMOOSAVE"
+#define STATE_VERSION 1
+
+typedef struct {
+    char Magic[8];
+    uint32_t Version;
+    uint32_t RawSize; //Bytes in the raw state, depends on the build and the cartridge RAM size
+    uint32_t PackedSize; //Compressed bytes after the header
+    uint8_t Title[16]; //ROM header 0x0134-0x0143
+    uint16_t ROMChecksum; //ROM header 0x014E-0x014F
+    uint8_t Delta; //Set if it was stored against a base state, and can only be loaded against that same base
+    uint8_t Padding;
+} StateHeader;
+
+size_t StateRawSize(DMG *DMG);
+size_t StateMaxSize(DMG *DMG); //Most bytes StateSave can write (Header included).
+void StateCapture(DMG *DMG, uint8_t *Raw); //Copies the machine into Raw (StateRawSize bytes).
+void StateRestore(DMG *DMG, const uint8_t *Raw); //Puts the machine back the way StateCapture found it, must be called on an instruction boundary (Between DMGStep calls).
+
+//Captures into Raw and writes the compressed state to Out, as a delta against Base (Another raw state) unless it is NULL. Returns the bytes written.
+size_t StateSave(DMG *DMG, uint8_t *Raw, const uint8_t *Base, uint8_t *Out);
+//Unpacks In into Raw and restores it, returns 0 on success or -1 (Leaving the machine alone) if it isn't a state of this game from this build.
+int StateLoad(DMG *DMG, uint8_t *Raw, const uint8_t *Base, const uint8_t *In, size_t Size);
+
+int StateSaveFile(DMG *DMG, const char *Path); //Returns 0 on success.
+int StateLoadFile(DMG *DMG, const char *Path); //Returns 0 on success, -1 if there's no usable state in the file.
+
+#endif // STATE_H
@@ -1,6 +1,5 @@
 #include <cstdio>
 #include <stdlib.h>
-#include <SDL2/SDL.h>
 #include "MMU.h"
 #include "Timer.h"
 
@@ -61,4 +60,69 @@ void TimerTick(Timer *Timer, MMU *MMU) {
     }
 
     return;
-}
\ No newline at end of file
+}
+
+//Same as calling TimerTick Ticks times, but jumps straight from one DIV/TIMA increment to the next.
+void TimerAdvance(Timer *Timer, MMU *MMU, int Ticks) {
+    //DIV goes up once every 257 calls of TimerTick (256 counts plus the reset)
+    int DivTotal = Timer->DivTickCount + Ticks;
+    MMU->SystemMemory[0xFF04] += DivTotal / 257;
+    Timer->DivTickCount = DivTotal % 257;
+
+    if ((MMU->SystemMemory[0xFF07] & 0x04) == 0) {
+        return;
+    }
+
+    int Threshold;
+    switch (MMU->SystemMemory[0xFF07] & 0x03) {
+        case 0x00: Threshold = 1024; break;
+        case 0x01: Threshold = 16; break;
+        case 0x02: Threshold = 64; break;
+        default: Threshold = 256; break;
+    }
+
+    while (Ticks > 0) {
+        //Ticks left until the next TIMA increment (At least one if TAC just lowered the threshold)
+        int Needed = Threshold - Timer->TimaTickCount;
+        if (Needed < 1) {
+            Needed = 1;
+        }
+        if (Ticks < Needed) {
+            Timer->TimaTickCount += Ticks;
+            break;
+        }
+        Ticks -= Needed;
+        Timer->TimaTickCount = 0;
+
+        if (MMU->SystemMemory[0xFF05] == 0xFF) { // Check for overflow
+            MMU->SystemMemory[0xFF05] = MMU->SystemMemory[0xFF06]; // Set TIMA to TMA
+            MMU->SystemMemory[0xFF0F] |= 0x04; // Set Timer Overflow Flag
+        } 
+        else {
+            MMU->SystemMemory[0xFF05]++; // Increment TIMA
+        }
+    }
+}
+
+//Ticks until the next DIV or TIMA increment (0 means the very next tick).
+int TimerNextEvent(Timer *Timer, MMU *MMU) {
+    int Next = 256 - Timer->DivTickCount;
+
+    if (MMU->SystemMemory[0xFF07] & 0x04) {
+        int Threshold;
+        switch (MMU->SystemMemory[0xFF07] & 0x03) {
+            case 0x00: Threshold = 1024; break;
+            case 0x01: Threshold = 16; break;
+            case 0x02: Threshold = 64; break;
+            default: Threshold = 256; break;
+        }
+        int Tima = Threshold - Timer->TimaTickCount - 1;
+        if (Tima < 0) {
+            Tima = 0;
+        }
+        if (Tima < Next) {
+            Next = Tima;
+        }
+    }
+    return Next;
+}
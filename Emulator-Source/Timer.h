@@ -18,5 +18,7 @@ typedef struct {
 
 void TimerInit(Timer *Timer, MMU *MMU);
 void TimerTick(Timer *Timer, MMU *MMU);
+void TimerAdvance(Timer *Timer, MMU *MMU, int Ticks); //Runs Ticks worth of TimerTick in one go.
+int TimerNextEvent(Timer *Timer, MMU *MMU); //Ticks until DIV or TIMA next changes, for the scheduler.
 
 #endif // TIMER_H
\ No newline at end of file
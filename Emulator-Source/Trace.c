@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Trace.h"
+
+//The ring positions are shared with the writer thread, headless builds only have the one thread.
+#ifndef HEADLESS
+#define TraceGet(Position) ((uint32_t)SDL_AtomicGet(&(Position)))
+#define TraceSet(Position, Value) SDL_AtomicSet(&(Position), (int)(Value))
+#else
+#define TraceGet(Position) (Position)
+#define TraceSet(Position, Value) ((Position) = (Value))
+#endif
+
+//Saves the records from Read up to Write, in two blocks when they wrap around the end of the ring.
+static void TraceWriteOut(Trace *Trace, uint32_t Read, uint32_t Write) {
+    while (Read != Write) {
+        uint32_t Index = Read & (TRACE_RECORDS - 1);
+        uint32_t Count = Write - Read;
+        if (Count > TRACE_RECORDS - Index) {
+            Count = TRACE_RECORDS - Index;
+        }
+        fwrite(&Trace->Ring[Index], sizeof(TraceRecord), Count, Trace->File);
+        Read += Count;
+    }
+}
+
+#ifndef HEADLESS
+//Writer thread, sleeps until the emulation thread has a chunk ready (or the trace is closing) and saves everything in the ring.
+static int TraceWriterThread(void *Data) {
+    Trace *Trace = (struct Trace *)Data;
+    int Quit = 0;
+
+    while (!Quit) {
+        SDL_SemWait(Trace->Wake);
+        Quit = SDL_AtomicGet(&Trace->Quit); //Read first, so the write position below already has the last record in it
+        uint32_t Write = TraceGet(Trace->WritePosition);
+        TraceWriteOut(Trace, TraceGet(Trace->ReadPosition), Write);
+        TraceSet(Trace->ReadPosition, Write);
+    }
+    return 0;
+}
+#endif
+
+Trace *TraceOpen(const char *Path) {
+    FILE *File = fopen(Path, "wb");
+    if (File == NULL) {
+        return NULL;
+    }
+    Trace *Trace = (struct Trace *)malloc(sizeof(struct Trace));
+    Trace->File = File;
+    Trace->Flushed = 0;
+    TraceSet(Trace->ReadPosition, 0);
+    TraceSet(Trace->WritePosition, 0);
+    fwrite(TRACE_MAGIC, 1, 8, File);
+
+#ifndef HEADLESS
+    SDL_AtomicSet(&Trace->Quit, 0);
+    Trace->Wake = SDL_CreateSemaphore(0);
+    Trace->Writer = SDL_CreateThread(TraceWriterThread, "Trace Writer", Trace);
+#endif
+    return Trace;
+}
+
+void TraceClose(Trace *Trace) {
+#ifndef HEADLESS
+    SDL_AtomicSet(&Trace->Quit, 1);
+    SDL_SemPost(Trace->Wake);
+    SDL_WaitThread(Trace->Writer, NULL);
+    SDL_DestroySemaphore(Trace->Wake);
+#else
+    TraceWriteOut(Trace, Trace->ReadPosition, Trace->WritePosition);
+#endif
+    fclose(Trace->File);
+    free(Trace);
+}
+
+TraceRecord *TraceNext(Trace *Trace) {
+    uint32_t Write = TraceGet(Trace->WritePosition);
+#ifndef HEADLESS
+    //The writer is a whole ring behind, keep waking it until there is room.
+    while (Write - TraceGet(Trace->ReadPosition) >= TRACE_RECORDS) {
+        SDL_SemPost(Trace->Wake);
+        SDL_Delay(1);
+    }
+#endif
+    return &Trace->Ring[Write & (TRACE_RECORDS - 1)];
+}
+
+void TraceCommit(Trace *Trace) {
+    uint32_t Write = TraceGet(Trace->WritePosition) + 1;
+    TraceSet(Trace->WritePosition, Write);
+
+    if (Write - Trace->Flushed >= TRACE_CHUNK) {
+        Trace->Flushed = Write;
+#ifndef HEADLESS
+        SDL_SemPost(Trace->Wake);
+#else
+        //Nobody else to do it, write out the ring once it's half full.
+        if (Write - Trace->ReadPosition >= TRACE_RECORDS / 2) {
+            TraceWriteOut(Trace, Trace->ReadPosition, Write);
+            Trace->ReadPosition = Write;
+        }
+#endif
+    }
+}
+
+int TraceConvert(const char *InputPath, const char *OutputPath) {
+    FILE *Input = fopen(InputPath, "rb");
+    if (Input == NULL) {
+        printf("Error: Could not open %s\n", InputPath);
+        return -1;
+    }
+    char Magic[8];
+    if (fread(Magic, 1, 8, Input) != 8 || memcmp(Magic, TRACE_MAGIC, 8) != 0) {
+        printf("Error: %s is not a trace file\n", InputPath);
+        fclose(Input);
+        return -1;
+    }
+    FILE *Output = fopen(OutputPath, "w");
+    if (Output == NULL) {
+        printf("Error: Could not create %s\n", OutputPath);
+        fclose(Input);
+        return -1;
+    }
+
+    //Same line CPULOG used to print for every instruction.
+    static TraceRecord Records[4096];
+    size_t Count;
+    uint64_t Total = 0;
+    while ((Count = fread(Records, sizeof(TraceRecord), 4096, Input)) > 0) {
+        for (size_t i = 0; i < Count; i++) {
+            TraceRecord *Record = &Records[i];
+            fprintf(Output, "A:%02X F:%02X B:%02X C:%02X D:%02X E:%02X H:%02X L:%02X RTC:%02X SP:%04X PC:%04X PCMEM:%02X,%02X,%02X,%02X\n",
+                    Record->A, Record->F, Record->B, Record->C, Record->D, Record->E, Record->H, Record->L, Record->RTC,
+                    Record->SP, Record->PC, Record->PCMem[0], Record->PCMem[1], Record->PCMem[2], Record->PCMem[3]);
+        }
+        Total += Count;
+    }
+
+    fclose(Input);
+    fclose(Output);
+    printf("Converted %llu instructions to %s\n", (unsigned long long)Total, OutputPath);
+    return 0;
+}
@@ -0,0 +1,57 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#ifndef HEADLESS
+#include <SDL2/SDL.h>
+#endif
+
+/*
+    Trace (Binary execution log)
+    CPU logging used to open log.log, print a line and close it again for every instruction, which made a few seconds of gameplay take minutes.
+    Now every instruction is stored as a fixed size binary record in a large ring buffer, and a writer thread empties the ring into the file in big
+    blocks. The emulation thread only ever copies 24 bytes, and only waits if the writer falls a whole ring behind (Nothing gets dropped).
+    Headless builds have no threads, so they write the ring out on the emulation thread once half of it has filled up.
+    "--convert-trace" turns a trace file back into the Gameboy Doctor text CPULOG used to print.
+
+    File layout: TRACE_MAGIC (8 bytes), then one TraceRecord after another in the host's byte order.
+*/
+#define TRACE_MAGIC "EMOOTRC1"
+#define TRACE_RECORDS (1 << 18) //Ring size in records (6 MB), must be a power of two
+#define TRACE_CHUNK (1 << 14) //Records the emulation thread lets pile up before it wakes the writer
+
+typedef struct {
+    uint32_t Cycle; //Tick the instruction started on (Low 32 bits, wraps every 17 minutes)
+    uint16_t SP;
+    uint16_t PC;
+    uint8_t A, F, B, C, D, E, H, L;
+    uint8_t PCMem[4]; //The 4 bytes at PC
+    uint8_t RTC; //MMU->RTCMode
+    uint8_t Padding[3];
+} TraceRecord;
+
+typedef struct Trace {
+    TraceRecord Ring[TRACE_RECORDS];
+    FILE *File;
+    uint32_t Flushed; //Where the emulation thread last woke the writer (or wrote the ring out itself)
+#ifndef HEADLESS
+    SDL_atomic_t ReadPosition; //Next record the writer saves, only moved by the writer
+    SDL_atomic_t WritePosition; //Next record the emulation thread fills, only moved by the emulation thread
+    SDL_atomic_t Quit;
+    SDL_sem *Wake;
+    SDL_Thread *Writer;
+#else
+    uint32_t ReadPosition;
+    uint32_t WritePosition;
+#endif
+} Trace;
+
+Trace *TraceOpen(const char *Path); //Creates the file and starts the writer, returns NULL if the file can't be created.
+void TraceClose(Trace *Trace); //Writes out everything still in the ring, stops the writer and frees the trace.
+TraceRecord *TraceNext(Trace *Trace); //Emulation thread, the record to fill in next. Waits for room if the ring is full.
+void TraceCommit(Trace *Trace); //Emulation thread, hands the record from TraceNext over to the writer.
+
+int TraceConvert(const char *InputPath, const char *OutputPath); //Writes a trace file out as Gameboy Doctor text, returns 0 on success.
+
+#endif // TRACE_H
@@ -1,8 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <SDL2/SDL.h>
+#include <time.h>
 #include "DMG.h"
+#include "Display.h"
+#include "Trace.h"
+#include "State.h"
+#include "Movie.h"
+#include "Hash.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -77,13 +82,27 @@ int DMGPalette[12] = {
 int ROMSize;
 int RAMSize;
 int MBCType;
+uint8_t *ROMImage = NULL; //The mapped ROM file, shared by every DMG instead of each one keeping a copy.
+size_t ROMImageSize = 0;
 int LoadSaveFile = 0;
 int Exit = 0;
-int RenderingSpeed = 13;
+int FastForwardFrames = 10; //While holding Tab only every Nth frame gets drawn and shown
+int EmulationSpeed = 100; //Percent of the Game Boy's real speed, changed from the menu or with Q/W/E while playing
+int RewindMemory = 64; //Megabytes kept for rewinding, about a minute of most games at the default interval
+int RewindInterval = 1; //Frames between rewind snapshots, each step back while holding Backspace goes back this many frames
+int MovieMode = MOVIE_OFF; //Set by --record or --play, the Display records or plays MoviePath from power on
+char MoviePath[512];
 int LOG = 0;
+Trace *CPUTrace = NULL; //Open while CPU logging is on, CPULOG adds every instruction to it
 int SCALE = 5;
 int TargetFPS = 120;
+#ifdef HEADLESS
+int Headless = 1; //Headless builds never touch SDL.
+#else
+int Headless = 0; //Set by --headless, runs the core uncapped without a window or audio device.
+#endif
 
+#ifndef HEADLESS
 //SDL Globals
 SDL_Window *window;
 SDL_Renderer *renderer;
@@ -91,9 +110,15 @@ SDL_Texture* texture;
 SDL_AudioSpec audio;
 SDL_AudioSpec audio2;
 SDL_AudioDeviceID audioDevice;
+#endif
 
 //Used Function for Readability Purposes.
 void GetROMInfo();
+int ReadROMHeader(const char *Path);
+int RunHeadless(const char *Path, int Frames, const char *StatePath);
+int RunDispatchBenchmark(const char *Path, int Frames);
+int RunMovie(const char *Path, const char *MoviePath);
+int RunHashes(const char *Path, int Frames, const char *GoldenPath);
 
 
 int main(int argc, char *argv[]) 
@@ -101,6 +126,40 @@ int main(int argc, char *argv[])
 	int MenuChoice = 0;
 	int flag = 0;
 
+	//Headless runs skip the menu entirely: EMOO-Boy --headless <ROM Path> [Frames] [State Path]
+	//Dispatch benchmark: EMOO-Boy --bench-dispatch <ROM Path> [Frames]
+	//CPU log conversion: EMOO-Boy --convert-trace <Trace Path> [Output Path], writes the Gameboy Doctor text (log.log by default)
+	//Movie verification: EMOO-Boy --verify-movie <ROM Path> <Movie Path>, plays the movie headless and uncapped and prints the final state's hash
+	//Movies: EMOO-Boy --record <Movie Path> or --play <Movie Path>, then pick the ROM from the menu as usual
+	//Output hashes: EMOO-Boy --hash <ROM Path> [Frames] [Golden Path], prints every frame's video and audio hash or compares them against a golden file
+	if (argc > 2 && strcmp(argv[1], "--bench-dispatch") == 0) {
+		return RunDispatchBenchmark(argv[2], (argc > 3) ? atoi(argv[3]) : 300);
+	}
+	if (argc > 2 && strcmp(argv[1], "--convert-trace") == 0) {
+		return (TraceConvert(argv[2], (argc > 3) ? argv[3] : "log.log") == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	if (argc > 3 && strcmp(argv[1], "--verify-movie") == 0) {
+		return RunMovie(argv[2], argv[3]);
+	}
+	if (argc > 2 && strcmp(argv[1], "--hash") == 0) {
+		return RunHashes(argv[2], (argc > 3) ? atoi(argv[3]) : 600, (argc > 4) ? argv[4] : NULL);
+	}
+#ifdef HEADLESS
+	if (argc < 2) {
+		printf("Usage: %s <ROM Path> [Frames] [State Path]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	return RunHeadless(argv[1], (argc > 2) ? atoi(argv[2]) : 600, (argc > 3) ? argv[3] : NULL);
+#else
+	if (argc > 2 && strcmp(argv[1], "--headless") == 0) {
+		return RunHeadless(argv[2], (argc > 3) ? atoi(argv[3]) : 600, (argc > 4) ? argv[4] : NULL);
+	}
+	if (argc > 2 && (strcmp(argv[1], "--record") == 0 || strcmp(argv[1], "--play") == 0)) {
+		MovieMode = (strcmp(argv[1], "--record") == 0) ? MOVIE_RECORDING : MOVIE_PLAYING;
+		snprintf(MoviePath, sizeof(MoviePath), "%s", argv[2]);
+	}
+#endif
+
 	printf("Welcome to Emoo-Boy!\n \n");
 	
     while (flag != 1) {
@@ -108,10 +167,11 @@ int main(int argc, char *argv[])
 		printf("1. Load ROM File\n");
 		printf("2. Update Colors\n");
 		printf("3. Update Scale Factor\n");
-		printf("4. Update Internal Game Logic\n");
+		printf("4. Update Emulation Speed\n");
 		printf("5. Update Rendering FPS\n");
 		printf("6. Help/Controls \n");
-		printf("7. Toggle CPU Logging \n \n");
+		printf("7. Toggle CPU Logging \n");
+		printf("8. Update Rewind Settings \n \n");
 		
 		scanf("%d", &MenuChoice);
 		
@@ -169,10 +229,13 @@ int main(int argc, char *argv[])
 				break;
 			}
 			case (4): {
-				printf("Enter how many scanlines between 1 ms delays. (Default is 13, 20 is good if using proton.) \n");
-				printf("This function essentially controls the speed that games play at. \n");
+				printf("Enter the emulation speed as a percentage of a real Game Boy. (Default is 100, 200 runs twice as fast) \n");
+				printf("This controls the speed that games play at, no matter how fast the monitor refreshes. Hold Tab while playing to run uncapped. \n");
 
-				scanf("%d", &RenderingSpeed);
+				scanf("%d", &EmulationSpeed);
+				if (EmulationSpeed < 1) {
+					EmulationSpeed = 100;
+				}
 
 				printf("\n \n");
 				break;
@@ -180,8 +243,8 @@ int main(int argc, char *argv[])
 			}
 			case (5): {
 				printf("Enter the new target FPS for rendering. (Default is 60) \n");
-				printf("This function only changes the speed of the display rendering, not the internal game logic. \n");
-				printf("It's essentially interpolation. \n");
+				printf("This function only changes how often the window is redrawn, not the speed of the game. \n");
+				printf("The window still can't redraw faster than the monitor refreshes. \n");
 				scanf("%d", &TargetFPS);
 
 				printf("\n \n");
@@ -197,7 +260,11 @@ int main(int argc, char *argv[])
 				printf("ESC: Exit Emulator and Save Game.\n");
 				printf("Q: Slow Down Emulator\n");
 				printf("W: Speed Up Emulator\n");
-				printf("R: Reset Emulation Speed\n \n");
+				printf("E: Reset Emulation Speed\n");
+				printf("Tab (Hold): Fast Forward (No audio, only every %dth frame is drawn)\n", FastForwardFrames);
+				printf("F5: Save State (<ROM Path>.state)\n");
+				printf("F8: Load State\n");
+				printf("Backspace (Hold): Rewind\n \n");
 
 				printf("For any inquires, please contact the developer: royemmanuel39@gmail.com \n \n");
 
@@ -205,7 +272,7 @@ int main(int argc, char *argv[])
 			}
 			case (7): {
 				if (LOG == 0) {
-					printf("CPU Logging Enabled \n \n");
+					printf("CPU Logging Enabled (Saved to log.bin, convert it to text with --convert-trace) \n \n");
 					LOG = 1;
 				}
 				else if (LOG == 1) {
@@ -214,6 +281,21 @@ int main(int argc, char *argv[])
 				}
 				break;
 			}
+			case (8): {
+				printf("Enter the memory to keep for rewinding in megabytes. (Default is 64, 0 turns rewinding off) \n");
+				scanf("%d", &RewindMemory);
+				if (RewindMemory < 0) {
+					RewindMemory = 64;
+				}
+				printf("Enter how many frames to run between rewind snapshots. (Default is 1, higher values rewind further in the same memory but in bigger steps) \n");
+				scanf("%d", &RewindInterval);
+				if (RewindInterval < 1) {
+					RewindInterval = 1;
+				}
+
+				printf("\n \n");
+				break;
+			}
 			default: {
 				printf("Input Invalid, please try again. \n \n");
 				break;
@@ -221,29 +303,48 @@ int main(int argc, char *argv[])
 		}
 	}
 
-	//Create Gameboy Struct;
-	DMG Gameboy;
-	//Run Gameboy Init
-	DMGInit(&Gameboy);
-
-	//Main Loop
-	while (!Exit) { //SDL Scancode quit
-		DMGTick(&Gameboy);
+	if (LOG == 1) {
+		CPUTrace = TraceOpen("log.bin");
+		if (CPUTrace == NULL) {
+			printf("Error: Could not create log.bin, CPU Logging Disabled \n \n");
+			LOG = 0;
+		}
 	}
+
+	//Create Gameboy Struct (Too large for the stack once the frame buffers are included)
+	DMG *Gameboy = (DMG *)malloc(sizeof(DMG));
+	//Run Gameboy Init
+	DMGInit(Gameboy);
+
+#ifndef HEADLESS
+	//Main Loop, the core runs on its own thread while this one presents frames and reads the keyboard until ESC or the window is closed.
+	Display *Screen = (Display *)malloc(sizeof(Display));
+	DisplayInit(Screen, Gameboy);
+	DisplayRun(Screen);
+	free(Screen);
+#endif
 	
 	// On Program Exit
-	if (LoadSaveFile == 1) {
-		MMUSaveFile(&Gameboy.DMG_MMU);
+	if (CPUTrace != NULL) {
+		TraceClose(CPUTrace);
+		CPUTrace = NULL;
+	}
+	//A movie plays with its own cartridge RAM, the player's save stays as it was
+	if (LoadSaveFile == 1 && MovieMode != MOVIE_PLAYING) {
+		MMUSaveFile(&Gameboy->DMG_MMU);
 	}
 	
+#ifndef HEADLESS
 	// Close SDL
 	SDL_DestroyTexture(texture);
 	SDL_DestroyRenderer(renderer);
 	SDL_DestroyWindow(window);
 	SDL_Quit();
+#endif
 
 	// Free MMU Memory
-	MMUFree(&Gameboy.DMG_MMU);
+	MMUFree(&Gameboy->DMG_MMU);
+	free(Gameboy);
 
 
     return EXIT_SUCCESS;
@@ -254,9 +355,6 @@ void GetROMInfo() {
 	char ROMName[256]; //I doubt a ROM name will be larger than 256 chars
 	char RAMName[256]; 
 	int FileSize;
-	unsigned char ramSizeByte;
-	unsigned char romSizeByte;
-	unsigned char MBCByte;
 	int RAMChoice = 0;
 
     printf("\nOpening file dialog to select ROM file...\n");
@@ -285,22 +383,95 @@ void GetROMInfo() {
     snprintf(ROMFilePath, sizeof(ROMFilePath), "ROM/%s", ROMName);
 #endif
 
-    FILE *romFile = fopen(ROMFilePath, "rb");
-    
-	if (romFile == NULL) {
-        printf("Error: Could not open ROM file %s\n", ROMFilePath);
+    FileSize = ReadROMHeader(ROMFilePath);
+	if (FileSize < 0) {
         return;
     }
 
+	if (RAMSize > 0) {
+		printf("\nThis ROM has a Save file associated with it. \n");
+		printf("Would you like to load in a Save file? \n");
+		printf("If you do not, your game will NOT be saved.\n");
+		printf("1. Yes \n");
+		printf("2. No \n \n");
+
+		scanf("%d", &LoadSaveFile);
+
+		if (LoadSaveFile == 1) {
+			printf("\nOpening file dialog for Save file...\n");
+#ifdef _WIN32
+			if (!OpenFileDialog(RAMFilePath, sizeof(RAMFilePath), "Select or Create Save File", "Game Boy Save Files (*.sav)\0*.sav\0All Files (*.*)\0*.*\0", "Battery")) {
+				char baseName[256] = {0};
+				strncpy(baseName, ROMName, sizeof(baseName) - 1);
+				char *dot = strrchr(baseName, '.');
+				if (dot) *dot = '\0';
+				snprintf(RAMFilePath, sizeof(RAMFilePath), "Battery/%s.sav", baseName);
+				printf("No file selected in dialog. Defaulting save path to: %s\n", RAMFilePath);
+			} else {
+				printf("Save File Path set to: %s\n", RAMFilePath);
+			}
+#else
+			printf("\nPlease enter the Save file name: \n");
+			int FlushInput;
+			while ((FlushInput = getchar()) != '\n' && FlushInput != EOF);
+			fgets(RAMName, sizeof(RAMName), stdin);
+			RAMName[strcspn(RAMName, "\n")] = 0;
+			snprintf(RAMFilePath, sizeof(RAMFilePath), "Battery/%s", RAMName);
+			printf("\nSave File Loaded! \n");
+#endif
+		}
+		else {
+			printf("\nNo Save file loaded, proceeding with program. \n");
+		}
+	}
+
+    printf("\nROM Info for %s \n \n", ROMName);
+
+    printf("File Size: %d bytes\n", FileSize);
+	printf("ROM Size: %d bytes\n", ROMSize);
+	printf("RAM Size: %d bytes\n", RAMSize);
+	printf("MBC Type: 0x%x \n \n", MBCType);
+
+	printf("Note: The MBCType Value is the hexademical value of the MBC Type, please reference the PanDocs to confirm accuracy. \n");
+	printf("Note: Not all MBC Features are implemented yet, please remember to confirm that the File Size and ROM Size are the same. \n");
+
+	if (RAMChoice == 1) {
+		printf("Note: The Save File has been loaded, and will be updated when you choose to exit the emulator. \n");
+	}
+
+    // Pause Program
+	printf("\nPress Enter to Start Game...\n");
+
+    getchar();
+}
+
+//Maps the ROM and reads the ROM size, RAM size and MBC type straight out of the cartridge header, returns the file size (or -1 if the file can't be opened).
+int ReadROMHeader(const char *Path) {
+	unsigned char ramSizeByte;
+	unsigned char romSizeByte;
+	unsigned char MBCByte;
 
+	if (ROMImage != NULL) {
+		MMUUnmapROM(ROMImage, ROMImageSize);
+		ROMImage = NULL;
+		ROMImageSize = 0;
+	}
 
-    // find the length of the file. (ROM Size)
-    fseek(romFile, 0, SEEK_END);
-    FileSize = ftell(romFile);
+	ROMImage = MMUMapROM(Path, &ROMImageSize);
+	if (ROMImage == NULL) {
+        printf("Error: Could not open ROM file %s\n", Path);
+        return -1;
+    }
+	if (ROMImageSize < 0x150) {
+		printf("Error: %s is too small to be a ROM file\n", Path);
+		MMUUnmapROM(ROMImage, ROMImageSize);
+		ROMImage = NULL;
+		ROMImageSize = 0;
+		return -1;
+	}
 
 	//find the rom size
-	fseek(romFile, 0x148, SEEK_SET);
-	fread(&romSizeByte, sizeof(unsigned char), 1, romFile);   
+	romSizeByte = ROMImage[0x148];
 	switch (romSizeByte) {
 	case (0x00): //32KB (2 Banks)
 		ROMSize = 32768;
@@ -345,8 +516,7 @@ void GetROMInfo() {
 	} 
 
 	//find the ram size
-	fseek(romFile, 0x149, SEEK_SET);
-	fread(&ramSizeByte, sizeof(unsigned char), 1, romFile);
+	ramSizeByte = ROMImage[0x149];
 	
 	switch (ramSizeByte) {
 		case (0x00):
@@ -373,65 +543,287 @@ void GetROMInfo() {
 	}
 
 	//find the MBC type
-	fseek(romFile, 0x147, SEEK_SET);
-	fread(&MBCByte, sizeof(unsigned char), 1, romFile);
+	MBCByte = ROMImage[0x147];
 	MBCType = MBCByte;
-	fclose(romFile);
 
-	if (RAMSize > 0) {
-		printf("\nThis ROM has a Save file associated with it. \n");
-		printf("Would you like to load in a Save file? \n");
-		printf("If you do not, your game will NOT be saved.\n");
-		printf("1. Yes \n");
-		printf("2. No \n \n");
+	return (int)ROMImageSize;
+}
 
-		scanf("%d", &LoadSaveFile);
+//Runs the ROM without a window, audio device or frame cap and reports the raw emulation speed.
+//With a state path the run carries on from the state saved there (if there is one) and saves its own state back when it's done.
+int RunHeadless(const char *Path, int Frames, const char *StatePath) {
+	int16_t AudioScratch[8192];
+	
+	Headless = 1;
+	LoadSaveFile = 0;
+	snprintf(ROMFilePath, sizeof(ROMFilePath), "%s", Path);
 
-		if (LoadSaveFile == 1) {
-			printf("\nOpening file dialog for Save file...\n");
-#ifdef _WIN32
-			if (!OpenFileDialog(RAMFilePath, sizeof(RAMFilePath), "Select or Create Save File", "Game Boy Save Files (*.sav)\0*.sav\0All Files (*.*)\0*.*\0", "Battery")) {
-				char baseName[256] = {0};
-				strncpy(baseName, ROMName, sizeof(baseName) - 1);
-				char *dot = strrchr(baseName, '.');
-				if (dot) *dot = '\0';
-				snprintf(RAMFilePath, sizeof(RAMFilePath), "Battery/%s.sav", baseName);
-				printf("No file selected in dialog. Defaulting save path to: %s\n", RAMFilePath);
-			} else {
-				printf("Save File Path set to: %s\n", RAMFilePath);
-			}
-#else
-			printf("\nPlease enter the Save file name: \n");
-			int FlushInput;
-			while ((FlushInput = getchar()) != '\n' && FlushInput != EOF);
-			fgets(RAMName, sizeof(RAMName), stdin);
-			RAMName[strcspn(RAMName, "\n")] = 0;
-			snprintf(RAMFilePath, sizeof(RAMFilePath), "Battery/%s", RAMName);
-			printf("\nSave File Loaded! \n");
-#endif
+	if (ReadROMHeader(ROMFilePath) < 0) {
+		return EXIT_FAILURE;
+	}
+
+	//Too large for the stack once the frame buffers are included.
+	DMG *Gameboy = (DMG *)malloc(sizeof(DMG));
+	DMGInit(Gameboy);
+	if (StatePath != NULL && StateLoadFile(Gameboy, StatePath) == 0) {
+		printf("Resumed from %s\n", StatePath);
+	}
+
+	clock_t Start = clock();
+	int Frame;
+	for (Frame = 0; Frame < Frames && !Exit; Frame++) {
+		DMGRunFrame(Gameboy);
+		DMGGetAudio(Gameboy, AudioScratch, 4096);
+	}
+	double Seconds = (double)(clock() - Start) / CLOCKS_PER_SEC;
+
+	printf("Ran %d frames in %.3f seconds", Frame, Seconds);
+	if (Seconds > 0) {
+		printf(" (%.1f FPS, %.2fx real time)", Frame / Seconds, (Frame / Seconds) / 59.73);
+	}
+	printf("\n");
+	printf("Tile decoder: %s\n", PPUDecoder());
+
+	if (StatePath != NULL) {
+		if (StateSaveFile(Gameboy, StatePath) == 0) {
+			printf("State saved to %s\n", StatePath);
 		}
 		else {
-			printf("\nNo Save file loaded, proceeding with program. \n");
+			printf("Error: Could not save the state to %s\n", StatePath);
 		}
 	}
 
-    printf("\nROM Info for %s \n \n", ROMName);
+	MMUFree(&Gameboy->DMG_MMU);
+	free(Gameboy);
+	return EXIT_SUCCESS;
+}
 
-    printf("File Size: %d bytes\n", FileSize);
-	printf("ROM Size: %d bytes\n", ROMSize);
-	printf("RAM Size: %d bytes\n", RAMSize);
-	printf("MBC Type: 0x%x \n \n", MBCType);
+//Plays a movie without a window or frame cap. The hash covers the whole machine at the end (Frame included), so two runs that print the same one ended up identical.
+int RunMovie(const char *Path, const char *MoviePath) {
+	int16_t AudioScratch[8192];
 
-	printf("Note: The MBCType Value is the hexademical value of the MBC Type, please reference the PanDocs to confirm accuracy. \n");
-	printf("Note: Not all MBC Features are implemented yet, please remember to confirm that the File Size and ROM Size are the same. \n");
+	Headless = 1;
+	LoadSaveFile = 0; //Power on movies bring their own cartridge RAM
+	snprintf(ROMFilePath, sizeof(ROMFilePath), "%s", Path);
 
-	if (RAMChoice == 1) {
-		printf("Note: The Save File has been loaded, and will be updated when you choose to exit the emulator. \n");
+	if (ReadROMHeader(ROMFilePath) < 0) {
+		return EXIT_FAILURE;
 	}
 
-    // Pause Program
-	printf("\nPress Enter to Start Game...\n");
+	DMG *Gameboy = (DMG *)malloc(sizeof(DMG));
+	DMGInit(Gameboy);
+	Movie Film;
+	MovieInit(&Film);
+	int Loaded = (MovieLoad(&Film, MoviePath) == 0);
+	if (Loaded && MoviePlay(&Film, Gameboy) != 0) {
+		printf("Error: %s starts from a save state made by another build\n", MoviePath);
+		Loaded = 0;
+	}
+	if (!Loaded) {
+		MovieFree(&Film);
+		MMUFree(&Gameboy->DMG_MMU);
+		free(Gameboy);
+		return EXIT_FAILURE;
+	}
 
-    getchar();
+	clock_t Start = clock();
+	uint8_t Buttons;
+	int Frame = 0;
+	while (MovieNextFrame(&Film, &Buttons)) {
+		DMGSetButtons(Gameboy, Buttons);
+		DMGRunFrame(Gameboy);
+		DMGGetAudio(Gameboy, AudioScratch, 4096);
+		Frame++;
+	}
+	double Seconds = (double)(clock() - Start) / CLOCKS_PER_SEC;
+
+	uint8_t *Raw = (uint8_t *)malloc(StateRawSize(Gameboy));
+	StateCapture(Gameboy, Raw);
+	printf("Played %d frames in %.3f seconds", Frame, Seconds);
+	if (Seconds > 0) {
+		printf(" (%.1f FPS)", Frame / Seconds);
+	}
+	printf("\n");
+	printf("Final state hash: %016llx\n", (unsigned long long)HashBytes(Raw, StateRawSize(Gameboy), 0));
+
+	free(Raw);
+	MovieFree(&Film);
+	MMUFree(&Gameboy->DMG_MMU);
+	free(Gameboy);
+	return EXIT_SUCCESS;
+}
+
+/*Output Hashes
+  Runs the ROM without a window or frame cap and hashes every frame and the audio that came with it, one "Frame Video Audio" line per frame.
+  Without a golden file the lines are printed (Redirect them into one), with one they are compared and the run stops at the first difference.
+*/
+int RunHashes(const char *Path, int Frames, const char *GoldenPath) {
+	int16_t Samples[4096 * 2];
+
+	Headless = 1;
+	LoadSaveFile = 0;
+	snprintf(ROMFilePath, sizeof(ROMFilePath), "%s", Path);
+
+	if (ReadROMHeader(ROMFilePath) < 0) {
+		return EXIT_FAILURE;
+	}
+	FILE *Golden = NULL;
+	if (GoldenPath != NULL) {
+		Golden = fopen(GoldenPath, "r");
+		if (Golden == NULL) {
+			printf("Error: Could not open %s\n", GoldenPath);
+			return EXIT_FAILURE;
+		}
+	}
+
+	DMG *Gameboy = (DMG *)malloc(sizeof(DMG));
+	DMGInit(Gameboy);
+
+	clock_t Start = clock();
+	int Frame;
+	int Match = 1;
+	for (Frame = 0; Frame < Frames && Match; Frame++) {
+		DMGRunFrame(Gameboy);
+		uint64_t Video = DMGFrameHash(Gameboy);
+		uint64_t Audio = 0;
+		int Count;
+		while ((Count = DMGGetAudio(Gameboy, Samples, 4096)) > 0) {
+			Audio = DMGAudioHash(Samples, Count, Audio);
+		}
+
+		if (Golden == NULL) {
+			printf("%d %016llx %016llx\n", Frame, (unsigned long long)Video, (unsigned long long)Audio);
+			continue;
+		}
+		int GoldenFrame;
+		unsigned long long GoldenVideo, GoldenAudio;
+		if (fscanf(Golden, "%d %llx %llx", &GoldenFrame, &GoldenVideo, &GoldenAudio) != 3 || GoldenFrame != Frame) {
+			printf("%s ends before frame %d\n", GoldenPath, Frame);
+			Match = 0;
+		}
+		else if (GoldenVideo != Video || GoldenAudio != Audio) {
+			printf("Frame %d differs:%s%s\n", Frame, (GoldenVideo != Video) ? " Video" : "", (GoldenAudio != Audio) ? " Audio" : "");
+			Match = 0;
+		}
+	}
+	double Seconds = (double)(clock() - Start) / CLOCKS_PER_SEC;
+
+	if (Golden != NULL) {
+		fclose(Golden);
+		if (Match) {
+			printf("All %d frames match %s (%.3f seconds)\n", Frame, GoldenPath, Seconds);
+		}
+	}
+	MMUFree(&Gameboy->DMG_MMU);
+	free(Gameboy);
+	return Match ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+/*Dispatch Benchmark
+  Records the instructions a normal run executes (registers and opcode bytes at the start of each one), then replays that fixed trace through the switch, table and computed goto dispatchers.
+  Only the CPU runs during the replay, so the difference between them is the dispatch cost.
+*/
+typedef struct {
+	CPU State;
+	uint8_t Bytes[3];
+} DispatchTraceEntry;
+
+#define DISPATCH_TRACE_MAX 1000000
+
+int RunDispatchBenchmark(const char *Path, int Frames) {
+	const char *Names[3] = {"Switch", "Table", "Computed Goto"};
+	uint8_t (*Dispatchers[3])(CPU *CPU, MMU *MMU) = {CPUExecuteSwitch, CPUExecuteTable, CPUExecuteGoto};
+	double Best[3];
+	uint32_t Checksum[3];
+
+	Headless = 1;
+	LoadSaveFile = 0;
+	snprintf(ROMFilePath, sizeof(ROMFilePath), "%s", Path);
+
+	if (ReadROMHeader(ROMFilePath) < 0) {
+		return EXIT_FAILURE;
+	}
+
+	DMG *Gameboy = (DMG *)malloc(sizeof(DMG));
+	DMG *Replay = (DMG *)malloc(sizeof(DMG));
+	DispatchTraceEntry *Trace = (DispatchTraceEntry *)malloc(sizeof(DispatchTraceEntry) * DISPATCH_TRACE_MAX);
+	uint8_t *RAMCopy = (uint8_t *)malloc(RAMSize + 1);
+	uint8_t *ReplayROM = (uint8_t *)malloc(ROMSize); //The replay pokes opcodes into its ROM, so it gets its own instead of the shared image
+	DMGInit(Gameboy);
+
+	//Record the trace
+	int Count = 0;
+	for (int Frame = 0; Frame < Frames && Count < DISPATCH_TRACE_MAX; Frame++) {
+		Gameboy->DMG_PPU.FrameReady = 0;
+		while (!Gameboy->DMG_PPU.FrameReady && Count < DISPATCH_TRACE_MAX) {
+			if (!Gameboy->DMG_CPU.HALT) {
+				DispatchTraceEntry *Entry = &Trace[Count++];
+				Entry->State = Gameboy->DMG_CPU;
+				for (int i = 0; i < 3; i++) {
+					Entry->Bytes[i] = MMURead(&Gameboy->DMG_MMU, (uint16_t)(Gameboy->DMG_CPU.PC + i));
+				}
+			}
+			DMGStep(Gameboy);
+		}
+	}
+	printf("Recorded %d instructions over %d frames.\n", Count, Frames);
+
+	//Replay it through each dispatcher, starting from the same memory every time. Best of 5 runs.
+	memcpy(RAMCopy, Gameboy->DMG_MMU.RAMFile, RAMSize);
+	for (int d = 0; d < 3; d++) {
+		Best[d] = 0;
+		for (int Run = 0; Run < 5; Run++) {
+			memcpy(Replay, Gameboy, sizeof(DMG));
+			memcpy(ReplayROM, Gameboy->DMG_MMU.ROMFile, ROMSize);
+			Replay->DMG_MMU.ROMFile = ReplayROM;
+			MMUMapPages(&Replay->DMG_MMU); //The copied page table still points into Gameboy
+			memcpy(Gameboy->DMG_MMU.RAMFile, RAMCopy, RAMSize);
+			Replay->DMG_MMU.WriteHook = NULL; //CPU only, no scheduler
+			Replay->DMG_MMU.SoundWrite = NULL;
+			CPU *ReplayCPU = &Replay->DMG_CPU;
+			MMU *ReplayMMU = &Replay->DMG_MMU;
+			uint32_t Sum = 0;
+
+			clock_t Start = clock();
+			for (int i = 0; i < Count; i++) {
+				*ReplayCPU = Trace[i].State;
+				for (int j = 0; j < 3; j++) {
+					//Code running out of ROM lives in ROMFile, so poke through the page table
+					uint16_t Address = (uint16_t)(ReplayCPU->PC + j);
+					uint8_t *Page = ReplayMMU->ReadPage[Address >> 8];
+					if (Page != NULL) {
+						Page[Address & 0xFF] = Trace[i].Bytes[j];
+					}
+					else {
+						ReplayMMU->SystemMemory[Address] = Trace[i].Bytes[j];
+					}
+				}
+				Sum += Dispatchers[d](ReplayCPU, ReplayMMU);
+				Sum = Sum * 31 + ReplayCPU->RegA + CPUGetFlags(ReplayCPU) + ReplayCPU->PC;
+			}
+			double Seconds = (double)(clock() - Start) / CLOCKS_PER_SEC;
+
+			if (Run == 0 || Seconds < Best[d]) {
+				Best[d] = Seconds;
+			}
+			Checksum[d] = Sum;
+		}
+	}
+	memcpy(Gameboy->DMG_MMU.RAMFile, RAMCopy, RAMSize);
+
+	for (int d = 0; d < 3; d++) {
+		printf("%-14s %7.2f ns/instruction", Names[d], (Count > 0) ? Best[d] * 1e9 / Count : 0.0);
+		if (Best[0] > 0) {
+			printf(" (%.2fx the switch)", Best[0] / Best[d]);
+		}
+		printf("%s\n", (Checksum[d] == Checksum[0]) ? "" : " RESULTS DIFFER FROM THE SWITCH");
+	}
+
+	MMUFree(&Gameboy->DMG_MMU);
+	free(RAMCopy);
+	free(ReplayROM);
+	free(Trace);
+	free(Replay);
+	free(Gameboy);
+	return EXIT_SUCCESS;
+}